@@ -39,6 +39,7 @@
 
 #include <fstream>
 #include <map>
+#include <queue>
 #include <vector>
 #include <set>
 #include <stdexcept>
@@ -48,6 +49,27 @@
 
 namespace gtry {
 
+namespace {
+
+/// Node budget of the visualize() helpers that are used for diagnostic dumps, beyond which node groups are collapsed.
+constexpr size_t DIAGNOSTIC_NODE_BUDGET = 2000;
+
+/// File stream with a large write buffer, since dot files are written in many tiny pieces.
+class BufferedFile : public std::ofstream
+{
+	public:
+		BufferedFile(const std::filesystem::path &path) : m_buffer(1 << 20) {
+			rdbuf()->pubsetbuf(m_buffer.data(), m_buffer.size());
+			open(path.string().c_str(), std::fstream::out);
+			if (!is_open())
+				throw std::runtime_error("Could not open file!");
+		}
+	protected:
+		std::vector<char> m_buffer;
+};
+
+}
+
 DotExport::DotExport(std::filesystem::path destination) : m_destination(std::move(destination))
 {
 }
@@ -75,16 +97,63 @@ void DotExport::operator()(const hlim::Circuit &circuit, hlim::NodeGroup *nodeGr
 
 void DotExport::writeDotFile(const hlim::Circuit &circuit, const hlim::ConstSubnet &subnet, hlim::NodeGroup *nodeGroup, const hlim::SignalDelay *signalDelays)
 {
-	std::fstream file(m_destination.string().c_str(), std::fstream::out);
-	if (!file.is_open())
-		throw std::runtime_error("Could not open file!");
-	file << "digraph G {" << std::endl;
+	BufferedFile file(m_destination);
+	file << "digraph G {" << '\n';
 
 	utils::StableMap<hlim::BaseNode*, unsigned> node2idx;
   //  utils::UnstableMap<hlim::NodeGroup*, unsigned> nodeGroup2idx;
 
+	// Node groups that are shown with their content, all others are collapsed into one summary node
+	utils::UnstableSet<const hlim::NodeGroup*> expandedGroups;
+	utils::UnstableMap<const hlim::NodeGroup*, size_t> groupNodeCount;
+	bool collapseGroups = m_nodeBudget != 0 && subnet.getNodes().size() > m_nodeBudget;
+	// Indices of summary nodes
+	std::vector<bool> isSummary;
+
+	const hlim::NodeGroup *topGroup = nodeGroup != nullptr ? nodeGroup : circuit.getRootNodeGroup();
+
+	if (collapseGroups) {
+		std::function<size_t(const hlim::NodeGroup *nodeGroup)> countNodes;
+		countNodes = [&](const hlim::NodeGroup *nodeGroup)->size_t {
+			size_t count = 0;
+			for (auto *node : nodeGroup->getNodes())
+				if (subnet.contains(node))
+					count++;
+			for (const auto &subGroup : nodeGroup->getChildren())
+				count += countNodes(subGroup.get());
+			groupNodeCount[nodeGroup] = count;
+			return count;
+		};
+		countNodes(topGroup);
+
+		// Expand breadth first, replacing the group's summary node by its nodes and the summary nodes of its children
+		size_t numShown = 1;
+		std::queue<const hlim::NodeGroup*> openList;
+		openList.push(topGroup);
+		while (!openList.empty()) {
+			auto *group = openList.front();
+			openList.pop();
+
+			size_t expandedSize = 0;
+			for (auto *node : group->getNodes())
+				if (subnet.contains(node))
+					expandedSize++;
+			for (const auto &subGroup : group->getChildren())
+				if (groupNodeCount[subGroup.get()] > 0)
+					expandedSize++;
+
+			if (numShown - 1 + expandedSize > m_nodeBudget) continue;
+
+			numShown += expandedSize - 1;
+			expandedGroups.insert(group);
+			for (const auto &subGroup : group->getChildren())
+				if (groupNodeCount[subGroup.get()] > 0)
+					openList.push(subGroup.get());
+		}
+	}
+
 
-	auto styleNode = [](std::fstream &file, hlim::BaseNode *node) {
+	auto styleNode = [](std::ostream &file, hlim::BaseNode *node) {
 		if (dynamic_cast<hlim::Node_Register*>(node))
 			file << " shape=\"box\" style=\"filled\" fillcolor=\"#a0a0ff\"";
 		else if (dynamic_cast<hlim::Node_Constant*>(node))
@@ -113,23 +182,44 @@ void DotExport::writeDotFile(const hlim::Circuit &circuit, const hlim::ConstSubn
 		unsigned idx = 0;
 		unsigned graphIdx = 0;
 
+		std::function<void(const hlim::NodeGroup *nodeGroup, unsigned summaryIdx)> assignToSummary;
+		assignToSummary = [&](const hlim::NodeGroup *nodeGroup, unsigned summaryIdx) {
+			for (auto *node : nodeGroup->getNodes())
+				if (subnet.contains(node))
+					node2idx[node] = summaryIdx;
+			for (const auto &subGroup : nodeGroup->getChildren())
+				assignToSummary(subGroup.get(), summaryIdx);
+		};
+
 		std::function<void(const hlim::NodeGroup *nodeGroup)> reccurWalkNodeGroup;
 		reccurWalkNodeGroup = [&](const hlim::NodeGroup *nodeGroup) {
 
-			file << "subgraph cluster_" << graphIdx << "{" << std::endl;
+			if (collapseGroups && !expandedGroups.contains(nodeGroup)) {
+				if (groupNodeCount[nodeGroup] == 0) return;
+
+				file << "node_" << idx << "[label=\"" << nodeGroup->getInstanceName() << "\\n" << groupNodeCount[nodeGroup] << " nodes\"";
+				file << " shape=\"box3d\" style=\"filled\" fillcolor=\"#d0d0d0\"];" << '\n';
+				assignToSummary(nodeGroup, idx);
+				isSummary.resize(idx+1, false);
+				isSummary[idx] = true;
+				idx++;
+				return;
+			}
+
+			file << "subgraph cluster_" << graphIdx << "{" << '\n';
 		  //  nodeGroup2idx[nodeGroup] = graphIdx++;
 			graphIdx++;
 
-			file << " label=\"" << nodeGroup->getInstanceName() << "\";" << std::endl;
+			file << " label=\"" << nodeGroup->getInstanceName() << "\";" << '\n';
 			switch (nodeGroup->getGroupType()) {
 				case hlim::NodeGroup::GroupType::ENTITY:
-					file << " color=blue;" << std::endl;
+					file << " color=blue;" << '\n';
 				break;
 				case hlim::NodeGroup::GroupType::AREA:
-					file << " color=black; style=filled; fillcolor=azure; " << std::endl;
+					file << " color=black; style=filled; fillcolor=azure; " << '\n';
 				break;
 				case hlim::NodeGroup::GroupType::SFU:
-					file << " color=black; style=filled; fillcolor=beige;" << std::endl;
+					file << " color=black; style=filled; fillcolor=beige;" << '\n';
 				break;
 			}
 
@@ -165,17 +255,14 @@ void DotExport::writeDotFile(const hlim::Circuit &circuit, const hlim::ConstSubn
 					file << "\"";
 				}
 				styleNode(file, node);
-				file << "];" << std::endl;
+				file << "];" << '\n';
 				node2idx[node] = idx;
 				idx++;
 			}
 
-			file << "}" << std::endl;
+			file << "}" << '\n';
 		};
-		if (nodeGroup == nullptr)
-			reccurWalkNodeGroup(circuit.getRootNodeGroup());
-		else
-			reccurWalkNodeGroup(nodeGroup);
+		reccurWalkNodeGroup(topGroup);
 
 		for (auto &node : circuit.getNodes()) {
 			if (node->getGroup() == nullptr) {
@@ -191,13 +278,16 @@ void DotExport::writeDotFile(const hlim::Circuit &circuit, const hlim::ConstSubn
 				}
 				file << "\"";
 				styleNode(file, node.get());
-				file << "];" << std::endl;
+				file << "];" << '\n';
 				node2idx[node.get()] = idx;
 				idx++;
 			}
 		}
 	}
 
+	isSummary.resize(node2idx.size()+1, false);
+	std::set<std::pair<unsigned, unsigned>> summaryEdges;
+
 	for (auto &nodeIdx : node2idx) {
 		auto &node = nodeIdx.first;
 		unsigned nodeId = nodeIdx.second;
@@ -211,6 +301,13 @@ void DotExport::writeDotFile(const hlim::Circuit &circuit, const hlim::ConstSubn
 			
 			unsigned producerId = node2idx.find(producer.node)->second;
 
+			// Connections from, to, or within collapsed groups are only drawn once and without details
+			if (isSummary[producerId] || isSummary[nodeId]) {
+				if (producerId != nodeId && summaryEdges.insert({producerId, nodeId}).second)
+					file << "node_" << producerId << " -> node_" << nodeId << ";" << '\n';
+				continue;
+			}
+
 			auto type = hlim::getOutputConnectionType(producer);
 
 			file << "node_" << producerId << " -> node_" << nodeId << " [";
@@ -283,11 +380,11 @@ void DotExport::writeDotFile(const hlim::Circuit &circuit, const hlim::ConstSubn
 				file << " " << auxLabel;
 			file << "\"";
 
-			file << "];" << std::endl;
+			file << "];" << '\n';
 		}
 	}
 
-	file << "}" << std::endl;
+	file << "}" << '\n';
 }
 
 
@@ -491,10 +588,8 @@ void DotExport::writeMergedDotFile(const hlim::Circuit &circuit, const hlim::Con
 
 
 
-	std::fstream file(m_destination.string().c_str(), std::fstream::out);
-	if (!file.is_open())
-		throw std::runtime_error("Could not open file!");
-	file << "digraph G {" << std::endl;
+	BufferedFile file(m_destination);
+	file << "digraph G {" << '\n';
 
 	for (auto idx : utils::Range(areas.size())) {
 		if (hideNode[idx]) continue;
@@ -515,7 +610,7 @@ void DotExport::writeMergedDotFile(const hlim::Circuit &circuit, const hlim::Con
 */		
 		file << "\"";
 		file << " shape=\"box\"";
-		file << "];" << std::endl;
+		file << "];" << '\n';
 
 		{
 			std::string filename = (boost::format("area_%i") % idx).str();
@@ -541,7 +636,7 @@ void DotExport::writeMergedDotFile(const hlim::Circuit &circuit, const hlim::Con
 
 		file << "\"";
 		file << " shape=\"box\" style=\"filled\" fillcolor=\"beige\"";
-		file << "];" << std::endl;
+		file << "];" << '\n';
 	}
 
 
@@ -572,7 +667,7 @@ void DotExport::writeMergedDotFile(const hlim::Circuit &circuit, const hlim::Con
 
 		file << "\"";
 		file << " shape=\"box\" style=\"filled\" fillcolor=\"#a0a0ff\"";
-		file << "];" << std::endl;
+		file << "];" << '\n';
 	}	
 
 
@@ -592,10 +687,10 @@ void DotExport::writeMergedDotFile(const hlim::Circuit &circuit, const hlim::Con
 		else
 			file << " weight=1";
 
-		file << "];" << std::endl;
+		file << "];" << '\n';
 	}
 
-	file << "}" << std::endl;
+	file << "}" << '\n';
 }
 
 
@@ -610,6 +705,7 @@ void DotExport::runGraphViz(std::filesystem::path destination)
 void visualize(const hlim::Circuit &circuit, const std::string &filename, hlim::NodeGroup *nodeGroup)
 {
 	DotExport exp(filename+".dot");
+	exp.setNodeBudget(DIAGNOSTIC_NODE_BUDGET);
 	exp(circuit, nodeGroup);
 	exp.runGraphViz(filename+".svg");
 }
@@ -617,9 +713,45 @@ void visualize(const hlim::Circuit &circuit, const std::string &filename, hlim::
 void visualize(const hlim::Circuit &circuit, const std::string &filename, const hlim::ConstSubnet &subnet)
 {
 	DotExport exp(filename+".dot");
+	exp.setNodeBudget(DIAGNOSTIC_NODE_BUDGET);
 	exp(circuit, subnet);
 	exp.runGraphViz(filename+".svg");
 }
 
+void visualizeNeighborhood(const hlim::Circuit &circuit, const std::string &filename, const hlim::BaseNode *node, size_t numHops)
+{
+	visualize(circuit, filename, extractNeighborhood(node, numHops));
+}
+
+hlim::ConstSubnet extractNeighborhood(const hlim::BaseNode *node, size_t numHops)
+{
+	hlim::ConstSubnet neighborhood;
+	neighborhood.add(node);
+
+	std::vector<const hlim::BaseNode*> currentHop = { node };
+	std::vector<const hlim::BaseNode*> nextHop;
+	for ([[maybe_unused]] auto hop : utils::Range(numHops)) {
+		nextHop.clear();
+		for (auto *n : currentHop) {
+			for (auto i : utils::Range(n->getNumInputPorts())) {
+				auto driver = n->getDriver(i);
+				if (driver.node != nullptr && !neighborhood.contains(driver.node)) {
+					neighborhood.add(driver.node);
+					nextHop.push_back(driver.node);
+				}
+			}
+			for (auto i : utils::Range(n->getNumOutputPorts()))
+				for (auto np : n->getDirectlyDriven(i))
+					if (!neighborhood.contains(np.node)) {
+						neighborhood.add(np.node);
+						nextHop.push_back(np.node);
+					}
+		}
+		std::swap(currentHop, nextHop);
+	}
+
+	return neighborhood;
+}
+
 
 }
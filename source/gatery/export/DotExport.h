@@ -22,6 +22,7 @@
 namespace gtry::hlim {
 
 class Circuit;
+class BaseNode;
 class NodeGroup;
 class Subnet;
 class ConstSubnet;
@@ -55,6 +56,13 @@ class DotExport
 
 		void mergeCombinatoryNodes() { m_mergeCombinatoryNodes = true; }
 
+		/**
+		 * @brief Limits the number of nodes in the exported graph.
+		 * @details If the subnet has more nodes than the budget, node groups are expanded top down (breadth first) only as long as 
+		 * the budget allows. All remaining node groups are collapsed into a single summary node each. A budget of zero disables collapsing.
+		 */
+		void setNodeBudget(size_t nodeBudget) { m_nodeBudget = nodeBudget; }
+
 		/**
 		 * @brief Executes graphviz on the .dot file to produce an svg.
 		 * @details Requires prior invocation of the export.
@@ -64,6 +72,7 @@ class DotExport
 	protected:
 		std::filesystem::path m_destination;
 		bool m_mergeCombinatoryNodes = false;
+		size_t m_nodeBudget = 0;
 
 		void writeDotFile(const hlim::Circuit &circuit, const hlim::ConstSubnet &subnet, hlim::NodeGroup *nodeGroup, const hlim::SignalDelay *signalDelays);
 		void writeMergedDotFile(const hlim::Circuit &circuit, const hlim::ConstSubnet &subnet);
@@ -72,5 +81,10 @@ class DotExport
 
 void visualize(const hlim::Circuit &circuit, const std::string &filename, hlim::NodeGroup *nodeGroup = nullptr);
 void visualize(const hlim::Circuit &circuit, const std::string &filename, const hlim::ConstSubnet &subnet);
+/// Visualizes all nodes that are at most numHops (in either direction) away from the given node.
+void visualizeNeighborhood(const hlim::Circuit &circuit, const std::string &filename, const hlim::BaseNode *node, size_t numHops);
+
+/// Returns all nodes that can be reached from the given node by following at most numHops connections in either direction.
+hlim::ConstSubnet extractNeighborhood(const hlim::BaseNode *node, size_t numHops);
 
 }
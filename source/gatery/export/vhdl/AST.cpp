@@ -23,10 +23,14 @@
 #include "HelperPackage.h"
 #include "Block.h"
 #include "InterfacePackage.h"
+#include "ExportManifest.h"
 
 #include "../../hlim/Circuit.h"
 #include "../../hlim/Clock.h"
 #include "../../hlim/NodeGroup.h"
+#include "../../hlim/GraphTools.h"
+#include "../../utils/Parallel.h"
+#include "../../utils/Range.h"
 
 #include <fstream>
 #include <functional>
@@ -87,15 +91,15 @@ std::filesystem::path AST::getFilename(std::filesystem::path basePath, const std
 	return basePath / (name + m_codeFormatting->getFilenameExtension());
 }
 
-void AST::writeVHDL(std::filesystem::path destination, const std::map<std::string, std::string> &customVhdlFiles)
+void AST::writeVHDL(std::filesystem::path destination, const std::map<std::string, std::string> &customVhdlFiles, ExportManifest &manifest, size_t numThreads)
 {
 	if (destination.has_extension())
 	{
 		for (auto& entity : m_entities)
-			entity->writeSupportFiles(destination.parent_path());
+			if (entity->getDuplicateOf() == nullptr)
+				entity->writeSupportFiles(destination.parent_path());
 
-		std::ofstream file{ destination.c_str(), std::ofstream::binary };
-		file.exceptions(std::fstream::failbit | std::fstream::badbit);
+		std::stringstream file;
 
 		for (auto& package : m_packages)
 			package->writeVHDL(file);
@@ -103,37 +107,43 @@ void AST::writeVHDL(std::filesystem::path destination, const std::map<std::strin
 		for (const auto &pair : customVhdlFiles)
 			file << pair.second << std::endl;
 
-		for (auto* entity : this->getDependencySortedEntities())
-			entity->writeVHDL(file);
+		// Format entities into individual buffers concurrently, but concatenate them in dependency order.
+		auto sortedEntities = getDependencySortedEntities();
+		std::vector<std::string> buffers(sortedEntities.size());
+		utils::parallelFor(sortedEntities.size(), [&](size_t i) {
+			std::stringstream buffer;
+			sortedEntities[i]->writeVHDL(buffer);
+			buffers[i] = buffer.str();
+		}, numThreads);
+
+		for (const auto &buffer : buffers)
+			file << buffer;
+
+		manifest.writeFile(destination, file.str(), true);
 	}
 	else
 	{
 		for (auto& entity : m_entities)
-			entity->writeSupportFiles(destination);
+			if (entity->getDuplicateOf() == nullptr)
+				entity->writeSupportFiles(destination);
 
 		for (auto& package : m_packages) {
-			std::filesystem::path filePath = getFilename(destination, package->getName());
-
-			std::fstream file(filePath.string().c_str(), std::fstream::out);
-			file.exceptions(std::fstream::failbit | std::fstream::badbit);
+			std::stringstream file;
 			package->writeVHDL(file);
+			manifest.writeFile(getFilename(destination, package->getName()), file.str());
 		}
 
-		for (const auto &pair : customVhdlFiles) {
-			std::filesystem::path filePath = getFilename(destination, pair.first);
-
-			std::fstream file(filePath.string().c_str(), std::fstream::out);
-			file.exceptions(std::fstream::failbit | std::fstream::badbit);
-			file << pair.second;
-		}
-
-		for (auto& entity : m_entities) {
-			std::filesystem::path filePath = getFilename(destination, entity->getName());
+		for (const auto &pair : customVhdlFiles)
+			manifest.writeFile(getFilename(destination, pair.first), pair.second);
 
-			std::fstream file(filePath.string().c_str(), std::fstream::out);
-			file.exceptions(std::fstream::failbit | std::fstream::badbit);
+		// The AST and all names are fixed at this point, so entities can be formatted and written independently.
+		utils::parallelFor(m_entities.size(), [&](size_t i) {
+			auto &entity = m_entities[i];
+			if (entity->getDuplicateOf() != nullptr) return;
+			std::stringstream file;
 			entity->writeVHDL(file);
-		}
+			manifest.writeFile(getFilename(destination, entity->getName()), file.str());
+		}, numThreads);
 	}
 }
 
@@ -143,6 +153,8 @@ std::vector<Entity*> AST::getDependencySortedEntities()
 
 	std::function<void(Entity*)> reccurEntity;
 	reccurEntity = [&](Entity *entity) {
+		// Everything a duplicate instantiates is a duplicate as well
+		if (entity->getDuplicateOf() != nullptr) return;
 		reverseList.push_back(entity);
 		for (auto *subEnt : entity->getSubEntities())
 			reccurEntity(subEnt);
@@ -157,6 +169,35 @@ std::vector<Entity*> AST::getDependencySortedEntities()
 	return {reverseList.rbegin(), reverseList.rend()};
 }
 
+void AST::deduplicateEntities()
+{
+	// Children before parents, such that parents of duplicates already instantiate the shared entity when they are compared.
+	auto sortedEntities = getDependencySortedEntities();
+
+	std::vector<std::uint64_t> hashes(sortedEntities.size());
+	for (auto i : utils::Range(sortedEntities.size()))
+		if (auto *group = sortedEntities[i]->getNodeGroup())
+			hashes[i] = hlim::hashNodeGroupStructure(group);
+
+	utils::UnstableMap<std::uint64_t, size_t> numWithHash;
+	for (auto hash : hashes)
+		numWithHash[hash]++;
+
+	utils::UnstableMap<std::uint64_t, std::vector<std::pair<std::string, Entity*>>> canonicalEntities;
+	for (auto i : utils::Range(sortedEntities.size())) {
+		auto *entity = sortedEntities[i];
+		if (entity == getRootEntity() || numWithHash[hashes[i]] < 2) continue;
+
+		auto text = entity->formatWithoutName();
+		auto &candidates = canonicalEntities[hashes[i]];
+		auto it = std::find_if(candidates.begin(), candidates.end(), [&](const auto &c) { return c.first == text; });
+		if (it != candidates.end())
+			entity->setDuplicateOf(it->second);
+		else
+			candidates.emplace_back(std::move(text), entity);
+	}
+}
+
 bool AST::findLocalDeclaration(hlim::NodePort driver, std::vector<BaseGrouping*> &reversePath)
 {
 	if (m_entities.empty()) return false;
@@ -44,6 +44,7 @@ class BaseGrouping;
 class BasicBlock;
 class CodeFormatting;
 class Package;
+class ExportManifest;
 
 class InterfacePackageContent;
 
@@ -80,7 +81,8 @@ class AST
 		inline NamespaceScope &getNamespaceScope() { return m_namespaceScope; }
 		inline Hlim2AstMapping &getMapping() { return m_mapping; }
 
-		void writeVHDL(std::filesystem::path destination, const std::map<std::string, std::string> &customVhdlFiles);
+		/// Writes all packages and entities through the manifest. With numThreads != 1, entities are formatted concurrently (zero uses all hardware threads).
+		void writeVHDL(std::filesystem::path destination, const std::map<std::string, std::string> &customVhdlFiles, ExportManifest &manifest, size_t numThreads = 1);
 
 		std::filesystem::path getFilename(std::filesystem::path basePath, const std::string &name);
 
@@ -92,8 +94,16 @@ class AST
 
 		bool findLocalDeclaration(hlim::NodePort driver, std::vector<BaseGrouping*> &reversePath);
 
+		/// Returns all entities that need to be written, such that every entity comes after the entities it instantiates.
 		std::vector<Entity*> getDependencySortedEntities();
 
+		/**
+		 * @brief Detects entities that format to identical VHDL and lets all instances share the first one.
+		 * @details Only entities whose node groups have the same structural hash are formatted and compared.
+		 * Duplicates are instantiated under the name of the first entity and are not written themselves.
+		 */
+		void deduplicateEntities();
+
 		inline bool isPartOfExport(const hlim::BaseNode *node) const { return m_exportArea.contains(node); }
 		bool isEmpty(const hlim::NodeGroup *group, bool reccursive) const;
 	protected:
@@ -65,6 +65,8 @@ class BaseTestbenchRecorder : public sim::SimulatorCallbacks
 
 		struct Phase {
 			std::stringstream assertStatements;
+			/// Expected values of pins (msb first, '-' for don't care), only used by recorders that don't emit assert statements directly.
+			std::map<std::string, std::string> checks;
 			std::map<std::string, std::string> signalOverrides;
 			std::map<std::string, std::string> resetOverrides;
 		};
@@ -99,6 +99,7 @@ void Entity::buildFrom(hlim::NodeGroup *nodeGroup)
 {
 	HCL_ASSERT(nodeGroup->getGroupType() == hlim::NodeGroup::GroupType::ENTITY);
 
+	m_nodeGroup = nodeGroup;
 	m_comment = nodeGroup->getComment();
 
 	NodeGroupInfo grpInfo;
@@ -313,6 +314,25 @@ void Entity::writeVHDL(std::ostream &stream)
 	stream << "END impl;" << std::endl;
 }
 
+std::string Entity::formatWithoutName()
+{
+	std::string name = "__entity__";
+	std::swap(m_name, name);
+
+	std::stringstream stream;
+	writeVHDL(stream);
+
+	std::swap(m_name, name);
+	return stream.str();
+}
+
+void Entity::setDuplicateOf(Entity *canonical)
+{
+	HCL_ASSERT(canonical->m_duplicateOf == nullptr);
+	m_duplicateOf = canonical;
+	m_name = canonical->getName();
+}
+
 void Entity::writePortDeclaration(std::ostream &stream, size_t indentation)
 {
 	std::vector<std::string> portList = getPortsVHDL();
@@ -61,8 +61,19 @@ class Entity : public BasicBlock
 		std::map<std::string, std::set<std::string>> collectNeededLibraries();
 
 		virtual void writeSupportFiles(const std::filesystem::path &destination) const override;
+
+		/// Formats the entity like writeVHDL, but with a placeholder instead of its own name, such that identical entities produce identical text.
+		std::string formatWithoutName();
+
+		/// Marks this entity as identical to canonical. It takes on the canonical name, so instantiations refer to canonical, and is not written itself.
+		void setDuplicateOf(Entity *canonical);
+		inline Entity *getDuplicateOf() const { return m_duplicateOf; }
+
+		inline const hlim::NodeGroup *getNodeGroup() const { return m_nodeGroup; }
 	protected:
 		std::vector<std::unique_ptr<Block>> m_blocks;
+		const hlim::NodeGroup *m_nodeGroup = nullptr;
+		Entity *m_duplicateOf = nullptr;
 
 		virtual void writeLibrariesVHDL(std::ostream &stream);
 		virtual std::vector<std::string> getPortsVHDL();
@@ -0,0 +1,94 @@
+/*  This file is part of Gatery, a library for circuit design.
+	Copyright (C) 2021 Michael Offel, Andreas Ley
+
+	Gatery is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	Gatery is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#include "gatery/pch.h"
+#include "ExportManifest.h"
+
+#include <fstream>
+
+namespace gtry::vhdl {
+
+namespace {
+	/// 64 bit FNV-1a, stable across platforms and runs.
+	std::uint64_t hashContent(std::string_view content)
+	{
+		std::uint64_t hash = 0xCBF29CE484222325ull;
+		for (char c : content) {
+			hash ^= (unsigned char) c;
+			hash *= 0x100000001B3ull;
+		}
+		return hash;
+	}
+}
+
+void ExportManifest::load(std::filesystem::path manifestFilename)
+{
+	m_manifestFilename = std::move(manifestFilename);
+	m_hashes.clear();
+
+	std::ifstream file(m_manifestFilename.string().c_str());
+	if (!file) return;
+
+	std::string line;
+	while (std::getline(file, line)) {
+		auto separator = line.find(' ');
+		if (separator == std::string::npos) continue;
+		m_hashes[line.substr(separator+1)] = std::stoull(line.substr(0, separator), nullptr, 16);
+	}
+}
+
+void ExportManifest::save() const
+{
+	if (!isEnabled()) return;
+
+	std::fstream file(m_manifestFilename.string().c_str(), std::fstream::out);
+	file.exceptions(std::fstream::failbit | std::fstream::badbit);
+	for (const auto &[filename, hash] : m_hashes)
+		file << std::hex << std::setw(16) << std::setfill('0') << hash << ' ' << filename << '\n';
+}
+
+bool ExportManifest::writeFile(const std::filesystem::path &filename, std::string_view content, bool binary)
+{
+	std::string key;
+	std::uint64_t hash = 0;
+	if (isEnabled()) {
+		key = filename.lexically_normal().generic_string();
+		hash = hashContent(content);
+
+		std::lock_guard lock(m_mutex);
+		auto it = m_hashes.find(key);
+		if (it != m_hashes.end() && it->second == hash && std::filesystem::exists(filename)) {
+			m_numFilesSkipped++;
+			return false;
+		}
+	}
+
+	{
+		auto mode = binary ? (std::fstream::out | std::fstream::binary) : std::fstream::out;
+		std::fstream file(filename.string().c_str(), mode);
+		file.exceptions(std::fstream::failbit | std::fstream::badbit);
+		file.write(content.data(), content.size());
+	}
+
+	std::lock_guard lock(m_mutex);
+	if (isEnabled())
+		m_hashes[key] = hash;
+	m_numFilesWritten++;
+	return true;
+}
+
+}
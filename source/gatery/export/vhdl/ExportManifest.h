@@ -0,0 +1,57 @@
+/*  This file is part of Gatery, a library for circuit design.
+	Copyright (C) 2021 Michael Offel, Andreas Ley
+
+	Gatery is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	Gatery is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <filesystem>
+#include <string>
+#include <string_view>
+#include <map>
+#include <mutex>
+#include <cstdint>
+
+namespace gtry::vhdl {
+
+/**
+ * @brief Writes the files of an export and optionally skips those whose content did not change since the last export.
+ * @details When enabled, the content hashes of all written files are stored in a manifest file. A file is only skipped
+ * if it still exists and the hash of its new content matches the manifest. This avoids retriggering the incremental
+ * flows of synthesis tools on unchanged files. Without a manifest, all files are always written.
+ */
+class ExportManifest
+{
+	public:
+		/// Enables incremental writing and loads the hashes of the previous export (if any).
+		void load(std::filesystem::path manifestFilename);
+		/// Stores the hashes of all files known to the manifest.
+		void save() const;
+		inline bool isEnabled() const { return !m_manifestFilename.empty(); }
+
+		/// Writes the file unless its content is unchanged. Safe to call from multiple threads. Returns true if the file was written.
+		bool writeFile(const std::filesystem::path &filename, std::string_view content, bool binary = false);
+
+		inline size_t getNumFilesWritten() const { return m_numFilesWritten; }
+		inline size_t getNumFilesSkipped() const { return m_numFilesSkipped; }
+	protected:
+		std::filesystem::path m_manifestFilename;
+		std::map<std::string, std::uint64_t> m_hashes;
+		std::mutex m_mutex;
+		size_t m_numFilesWritten = 0;
+		size_t m_numFilesSkipped = 0;
+};
+
+}
@@ -34,7 +34,52 @@
 namespace gtry::vhdl {
 
 
-FileBasedTestbenchRecorder::FileBasedTestbenchRecorder(VHDLExport &exporter, AST *ast, sim::Simulator &simulator, std::filesystem::path basePath, std::string name) : BaseTestbenchRecorder(ast, simulator, std::move(name)), m_exporter(exporter)
+namespace {
+
+/// Vectors are padded to full hex digits (and at least one) to keep them readable by hread.
+size_t packedWidth(size_t width)
+{
+	return std::max<size_t>(4, (width + 3) / 4 * 4);
+}
+
+void writePackedHex(std::ostream &stream, const std::vector<bool> &bits)
+{
+	for (size_t digit = bits.size() / 4; digit-- > 0; ) {
+		unsigned v = 0;
+		for (size_t b = 4; b-- > 0; ) {
+			v <<= 1;
+			if (bits[digit*4 + b])
+				v |= 1;
+		}
+		stream << "0123456789ABCDEF"[v];
+	}
+}
+
+bool isScalar(VHDLDataType dataType)
+{
+	switch (dataType) {
+		case VHDLDataType::BOOL:
+		case VHDLDataType::BIT:
+		case VHDLDataType::STD_LOGIC:
+		case VHDLDataType::STD_ULOGIC:
+			return true;
+		default:
+			return false;
+	}
+}
+
+}
+
+void FileBasedTestbenchRecorder::PackedLayout::add(std::string name, size_t width, VHDLDataType dataType)
+{
+	if (width == 0 || slotIdx.contains(name)) return;
+
+	slotIdx[name] = slots.size();
+	slots.push_back({.name = std::move(name), .offset = this->width, .width = width, .dataType = dataType});
+	this->width += width;
+}
+
+FileBasedTestbenchRecorder::FileBasedTestbenchRecorder(VHDLExport &exporter, AST *ast, sim::Simulator &simulator, std::filesystem::path basePath, std::string name, bool packedTestVectors) : BaseTestbenchRecorder(ast, simulator, std::move(name)), m_exporter(exporter), m_packedTestVectors(packedTestVectors)
 {
 	m_dependencySortedEntities.push_back(m_name);
 	m_testVectorFilename = m_name + ".testvectors";
@@ -93,6 +138,22 @@ ARCHITECTURE tb OF )" << m_dependencySortedEntities.back() << R"( IS
 			outputIsBool[pinOutput] = conType.isBool();
 		}
 
+		if (m_packedTestVectors) {
+			const auto &decl = rootEntity->getNamespaceScope().get(ioPin);
+			m_packedChecks.add(name, conType.width, decl.dataType);
+			if (ioPin->isInputPin())
+				m_packedDrives.add(name, conType.width, decl.dataType);
+		}
+	}
+
+	if (m_packedTestVectors) {
+		for (auto c : m_resetsOfInterest)
+			m_packedDrives.add(rootEntity->getNamespaceScope().getReset((hlim::Clock *) c).name, 1, VHDLDataType::STD_LOGIC);
+
+		for (auto c : m_clocksOfInterest) {
+			m_packedClockIdx[c] = m_packedClockState.size();
+			m_packedClockState.push_back(false);
+		}
 	}
 
 	vhdlFile << R"(
@@ -110,6 +171,31 @@ ARCHITECTURE tb OF )" << m_dependencySortedEntities.back() << R"( IS
 	 
 	end function stringcompare;
 	)";
+
+	if (m_packedTestVectors)
+		vhdlFile << R"(
+	function unpack(defined : std_logic_vector; value : std_logic_vector; undefined : std_logic) return std_logic_vector is
+		variable result : std_logic_vector(value'length-1 downto 0);
+	begin
+		for i in 0 to value'length-1 loop
+			if defined(defined'low + i) = '1' then
+				result(i) := value(value'low + i);
+			else
+				result(i) := undefined;
+			end if;
+		end loop;
+		return result;
+	end function unpack;
+
+	function unpack(defined : std_logic; value : std_logic; undefined : std_logic) return std_logic is
+	begin
+		if defined = '1' then
+			return value;
+		else
+			return undefined;
+		end if;
+	end function unpack;
+	)";
 	
 
 	vhdlFile << "BEGIN" << std::endl;
@@ -145,6 +231,22 @@ ARCHITECTURE tb OF )" << m_dependencySortedEntities.back() << R"( IS
 	cf.indent(vhdlFile, 2);
 	vhdlFile << "FILE test_vector_file : text;" << std::endl;
 
+	if (m_packedTestVectors) {
+		auto declareVector = [&](std::string_view name, size_t width) {
+			cf.indent(vhdlFile, 2);
+			vhdlFile << "VARIABLE " << name << " : std_logic_vector(" << packedWidth(width)-1 << " downto 0);" << std::endl;
+		};
+		cf.indent(vhdlFile, 2);
+		vhdlFile << "VARIABLE v_record : character;" << std::endl;
+		declareVector("v_check_mask", m_packedChecks.slots.size());
+		declareVector("v_check_defined", m_packedChecks.width);
+		declareVector("v_check_value", m_packedChecks.width);
+		declareVector("v_drive_mask", m_packedDrives.slots.size());
+		declareVector("v_drive_defined", m_packedDrives.width);
+		declareVector("v_drive_value", m_packedDrives.width);
+		declareVector("v_clocks", m_packedClockState.size());
+	}
+
 
 	cf.indent(vhdlFile, 1);
 	vhdlFile << "BEGIN" << std::endl;
@@ -161,6 +263,24 @@ ARCHITECTURE tb OF )" << m_dependencySortedEntities.back() << R"( IS
 	cf.indent(vhdlFile, 2);
 	vhdlFile << "END IF;" << std::endl;
 
+	if (m_packedTestVectors)
+		writePackedVectorReader(vhdlFile);
+	else
+		writeTextVectorReader(vhdlFile, outputIsBool, outputIsDrivenByNetwork);
+
+	vhdlFile << "TB_testbench_is_done <= '1';" << std::endl;
+	vhdlFile << "WAIT;" << std::endl;
+	vhdlFile << "END PROCESS;" << std::endl;
+	vhdlFile << "END;" << std::endl;
+
+	m_writtenSimulationTime = 0;
+	m_flushIntervalStart = 0;
+}
+
+void FileBasedTestbenchRecorder::writeTextVectorReader(std::ostream &vhdlFile, const utils::StableMap<hlim::NodePort, bool> &outputIsBool, const utils::StableSet<hlim::NodePort> &outputIsDrivenByNetwork)
+{
+	CodeFormatting &cf = m_ast->getCodeFormatting();
+
 	cf.indent(vhdlFile, 2);
 	vhdlFile << "WHILE NOT endfile(test_vector_file) loop" << std::endl;
 
@@ -185,7 +305,7 @@ ARCHITECTURE tb OF )" << m_dependencySortedEntities.back() << R"( IS
 			vhdlFile << "readline(test_vector_file, v_line);" << std::endl;
 
 			cf.indent(vhdlFile, 5);
-			if (outputIsBool[p.first])
+			if (outputIsBool.find(p.first)->second)
 				vhdlFile << "read(v_line, v_" << p.second << ");" << std::endl;
 			else
 				vhdlFile << "bread(v_line, v_" << p.second << ");" << std::endl;
@@ -220,7 +340,7 @@ ARCHITECTURE tb OF )" << m_dependencySortedEntities.back() << R"( IS
 			vhdlFile << "readline(test_vector_file, v_line);" << std::endl;
 
 			cf.indent(vhdlFile, 5);
-			if (outputIsBool[p.first])
+			if (outputIsBool.find(p.first)->second)
 				vhdlFile << "read(v_line, v_" << p.second << ");" << std::endl;
 			else
 				vhdlFile << "bread(v_line, v_" << p.second << ");" << std::endl;
@@ -332,15 +452,90 @@ ARCHITECTURE tb OF )" << m_dependencySortedEntities.back() << R"( IS
 
 	cf.indent(vhdlFile, 2);
 	vhdlFile << "end loop;" << std::endl;
+}
 
+void FileBasedTestbenchRecorder::writePackedVectorReader(std::ostream &vhdlFile)
+{
+	CodeFormatting &cf = m_ast->getCodeFormatting();
+	auto *rootEntity = m_ast->getRootEntity();
 
-	vhdlFile << "TB_testbench_is_done <= '1';" << std::endl;
-	vhdlFile << "WAIT;" << std::endl;
-	vhdlFile << "END PROCESS;" << std::endl;
-	vhdlFile << "END;" << std::endl;
+	auto formatUnpack = [&](const PackedSlot &slot, std::string_view vectorPrefix, char undefined) {
+		std::stringstream unpack;
+		if (isScalar(slot.dataType))
+			unpack << "unpack(" << vectorPrefix << "_defined(" << slot.offset << "), " << vectorPrefix << "_value(" << slot.offset << "), '" << undefined << "')";
+		else {
+			std::string range = std::to_string(slot.offset + slot.width - 1) + " downto " + std::to_string(slot.offset);
+			unpack << "unpack(" << vectorPrefix << "_defined(" << range << "), " << vectorPrefix << "_value(" << range << "), '" << undefined << "')";
+		}
 
-	m_writtenSimulationTime = 0;
-	m_flushIntervalStart = 0;
+		std::stringstream converted;
+		cf.formatDataTypeConversion(converted, isScalar(slot.dataType) ? VHDLDataType::STD_LOGIC : VHDLDataType::STD_LOGIC_VECTOR, slot.dataType, unpack.str());
+		return converted.str();
+	};
+
+	cf.indent(vhdlFile, 2);
+	vhdlFile << "WHILE NOT endfile(test_vector_file) loop" << std::endl;
+
+	cf.indent(vhdlFile, 3);
+	vhdlFile << "readline(test_vector_file, v_line);" << std::endl;
+	cf.indent(vhdlFile, 3);
+	vhdlFile << "read(v_line, v_record);" << std::endl;
+
+	cf.indent(vhdlFile, 3);
+	vhdlFile << "IF v_record = 'P' THEN" << std::endl;
+
+		cf.indent(vhdlFile, 4);
+		vhdlFile << "read(v_line, time_in_ps);" << std::endl;
+		cf.indent(vhdlFile, 4);
+		vhdlFile << "wait for time_in_ps * 1 ps;" << std::endl;
+		for (auto name : { "v_check_mask", "v_check_defined", "v_check_value", "v_drive_mask", "v_drive_defined", "v_drive_value" }) {
+			cf.indent(vhdlFile, 4);
+			vhdlFile << "hread(v_line, " << name << ");" << std::endl;
+		}
+
+		for (auto i : utils::Range(m_packedChecks.slots.size())) {
+			const auto &slot = m_packedChecks.slots[i];
+			cf.indent(vhdlFile, 4);
+			vhdlFile << "IF v_check_mask(" << i << ") = '1' THEN" << std::endl;
+			cf.indent(vhdlFile, 5);
+			vhdlFile << "ASSERT std_match(" << slot.name << ", " << formatUnpack(slot, "v_check", '-') << ") severity failure;" << std::endl;
+			cf.indent(vhdlFile, 4);
+			vhdlFile << "END IF;" << std::endl;
+		}
+
+		for (auto i : utils::Range(m_packedDrives.slots.size())) {
+			const auto &slot = m_packedDrives.slots[i];
+			cf.indent(vhdlFile, 4);
+			vhdlFile << "IF v_drive_mask(" << i << ") = '1' THEN" << std::endl;
+			cf.indent(vhdlFile, 5);
+			vhdlFile << slot.name << " <= " << formatUnpack(slot, "v_drive", 'X') << ";" << std::endl;
+			cf.indent(vhdlFile, 4);
+			vhdlFile << "END IF;" << std::endl;
+		}
+
+	cf.indent(vhdlFile, 3);
+	vhdlFile << "ELSIF v_record = 'C' THEN" << std::endl;
+
+		cf.indent(vhdlFile, 4);
+		vhdlFile << "hread(v_line, v_clocks);" << std::endl;
+		for (auto &p : m_packedClockIdx) {
+			cf.indent(vhdlFile, 4);
+			vhdlFile << rootEntity->getNamespaceScope().getClock((hlim::Clock *) p.first).name << " <= v_clocks(" << p.second << ");" << std::endl;
+		}
+
+	cf.indent(vhdlFile, 3);
+	vhdlFile << "ELSE" << std::endl;
+
+	cf.indent(vhdlFile, 4);
+	vhdlFile << "REPORT \"An error occured while parsing the test vector file: Can't parse line:\" & v_line(1 to v_line'length);" << std::endl;
+	cf.indent(vhdlFile, 4);
+	vhdlFile << "ASSERT FALSE severity failure;" << std::endl;
+
+	cf.indent(vhdlFile, 3);
+	vhdlFile << "END IF;" << std::endl;
+
+	cf.indent(vhdlFile, 2);
+	vhdlFile << "end loop;" << std::endl;
 }
 
 void FileBasedTestbenchRecorder::onPowerOn()
@@ -365,13 +560,52 @@ void FileBasedTestbenchRecorder::onCommitState()
 
 
 
-void FileBasedTestbenchRecorder::advanceTimeTo(const hlim::ClockRational &simulationTime)
+std::uint64_t FileBasedTestbenchRecorder::advanceTimeTo(const hlim::ClockRational &simulationTime)
 {
 	auto timeDiffInPS = (simulationTime - m_writtenSimulationTime) * 1'000'000'000'000ull;
 	std::uint64_t roundedTimeDiffInPS = timeDiffInPS.numerator() / timeDiffInPS.denominator();
 
-	m_testbenchFile << "ADV\n" << roundedTimeDiffInPS << std::endl;
 	m_writtenSimulationTime += Seconds{roundedTimeDiffInPS, 1'000'000'000'000ull};
+	return roundedTimeDiffInPS;
+}
+
+void FileBasedTestbenchRecorder::writePackedPhase(const Phase &phase, std::uint64_t advanceInPS)
+{
+	std::vector<bool> checkMask(packedWidth(m_packedChecks.slots.size()), false);
+	std::vector<bool> checkDefined(packedWidth(m_packedChecks.width), false);
+	std::vector<bool> checkValue(packedWidth(m_packedChecks.width), false);
+	std::vector<bool> driveMask(packedWidth(m_packedDrives.slots.size()), false);
+	std::vector<bool> driveDefined(packedWidth(m_packedDrives.width), false);
+	std::vector<bool> driveValue(packedWidth(m_packedDrives.width), false);
+
+	// Values are msb first with anything but '0' and '1' being undefined
+	auto pack = [](const PackedLayout &layout, const std::string &name, const std::string &value, std::vector<bool> &mask, std::vector<bool> &defined, std::vector<bool> &bits) {
+		auto it = layout.slotIdx.find(name);
+		HCL_ASSERT(it != layout.slotIdx.end());
+		const auto &slot = layout.slots[it->second];
+		HCL_ASSERT(value.size() == slot.width);
+
+		mask[it->second] = true;
+		for (auto i : utils::Range(slot.width)) {
+			char c = value[slot.width - 1 - i];
+			defined[slot.offset + i] = c == '0' || c == '1';
+			bits[slot.offset + i] = c == '1';
+		}
+	};
+
+	for (const auto &p : phase.checks)
+		pack(m_packedChecks, p.first, p.second, checkMask, checkDefined, checkValue);
+	for (const auto &p : phase.signalOverrides)
+		pack(m_packedDrives, p.first, p.second, driveMask, driveDefined, driveValue);
+	for (const auto &p : phase.resetOverrides)
+		pack(m_packedDrives, p.first, p.second, driveMask, driveDefined, driveValue);
+
+	m_testbenchFile << "P " << advanceInPS;
+	for (const auto *bits : { &checkMask, &checkDefined, &checkValue, &driveMask, &driveDefined, &driveValue }) {
+		m_testbenchFile << ' ';
+		writePackedHex(m_testbenchFile, *bits);
+	}
+	m_testbenchFile << '\n';
 }
 
 void FileBasedTestbenchRecorder::flush(const hlim::ClockRational &flushIntervalEnd)
@@ -381,13 +615,17 @@ void FileBasedTestbenchRecorder::flush(const hlim::ClockRational &flushIntervalE
 	for (auto phaseIdx : utils::Range(m_phases.size())) {
 		const auto &phase = m_phases[phaseIdx];
 
-		if (phase.assertStatements.str().empty() && phase.signalOverrides.empty() && phase.resetOverrides.empty())
+		if (phase.assertStatements.str().empty() && phase.checks.empty() && phase.signalOverrides.empty() && phase.resetOverrides.empty())
 			continue;
 
-		if (phase.assertStatements.str().empty() && phase.signalOverrides.empty() && phase.resetOverrides.empty())
+		auto advanceInPS = advanceTimeTo(m_flushIntervalStart + interval * (1 + phaseIdx));
+
+		if (m_packedTestVectors) {
+			writePackedPhase(phase, advanceInPS);
 			continue;
+		}
 
-		advanceTimeTo(m_flushIntervalStart + interval * (1 + phaseIdx));
+		m_testbenchFile << "ADV\n" << advanceInPS << '\n';
 
 		m_testbenchFile << phase.assertStatements.str();
 		
@@ -409,9 +647,21 @@ void FileBasedTestbenchRecorder::onClock(const hlim::Clock *clock, bool risingEd
 {
 	if (!m_clocksOfInterest.contains(clock)) return;
 
+	if (m_packedTestVectors) {
+		m_packedClockState[m_packedClockIdx.find(clock)->second] = risingEdge;
+
+		std::vector<bool> clocks(packedWidth(m_packedClockState.size()), false);
+		std::copy(m_packedClockState.begin(), m_packedClockState.end(), clocks.begin());
+
+		m_testbenchFile << "C ";
+		writePackedHex(m_testbenchFile, clocks);
+		m_testbenchFile << '\n';
+		return;
+	}
+
 	auto *rootEntity = m_ast->getRootEntity();
 // todo
-	m_testbenchFile << "CLK\n" << rootEntity->getNamespaceScope().getClock((hlim::Clock *) clock).name << std::endl;
+	m_testbenchFile << "CLK\n" << rootEntity->getNamespaceScope().getClock((hlim::Clock *) clock).name << '\n';
 
 	if (risingEdge)
 		m_testbenchFile << "1\n";
@@ -464,6 +714,21 @@ void FileBasedTestbenchRecorder::onSimProcOutputRead(const hlim::NodePort &outpu
 	}
 
 	const auto& conType = hlim::getOutputConnectionType(drivingOutput);
+
+	if (m_packedTestVectors) {
+		std::string expected(conType.width, '-');
+		bool anyDefined = false;
+		for (auto i : utils::Range(conType.width))
+			if (state.get(sim::DefaultConfig::DEFINED, i)) {
+				expected[conType.width - 1 - i] = state.get(sim::DefaultConfig::VALUE, i) ? '1' : '0';
+				anyDefined = true;
+			}
+
+		if (anyDefined)
+			m_phases.back().checks[name_it->second] = std::move(expected);
+		return;
+	}
+
 	if (conType.isBool()) {
 		if (state.get(sim::DefaultConfig::DEFINED, 0)) {
 			m_phases.back().assertStatements << "CHECK" << std::endl << name_it->second << std::endl << state << std::endl;
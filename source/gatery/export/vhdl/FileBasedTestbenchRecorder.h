@@ -18,6 +18,7 @@
 #pragma once
 
 #include "BaseTestbenchRecorder.h"
+#include "VHDLSignalDeclaration.h"
 
 #include <gatery/utils/StableContainers.h>
 
@@ -37,10 +38,17 @@ namespace gtry::vhdl {
 class VHDLExport;
 class AST;
 
+/**
+ * @brief Records the simulation into a test vector file that is replayed by a generated VHDL testbench.
+ * @details In the text format, every pin override, expected value, clock, and reset change is written as a sequence of lines.
+ * In the packed format, each phase is a single line that holds the time advance and hex encoded, bit packed vectors: a mask of the checked pins, a mask of 
+ * the defined expected bits, the expected values, a mask of the driven pins (and resets), a mask of the defined driven bits, and the driven values.
+ * Clock changes are written as a line with all clock values.
+ */
 class FileBasedTestbenchRecorder : public BaseTestbenchRecorder
 {
 	public:
-		FileBasedTestbenchRecorder(VHDLExport &exporter, AST *ast, sim::Simulator &simulator, std::filesystem::path basePath, std::string name);
+		FileBasedTestbenchRecorder(VHDLExport &exporter, AST *ast, sim::Simulator &simulator, std::filesystem::path basePath, std::string name, bool packedTestVectors = false);
 		~FileBasedTestbenchRecorder();
 
 		virtual void onPowerOn() override;
@@ -58,6 +66,21 @@ class FileBasedTestbenchRecorder : public BaseTestbenchRecorder
 		virtual void onSimProcOutputRead(const hlim::NodePort &output, const sim::DefaultBitVectorState &state) override;
 
 	protected:
+		/// Range of bits of a pin (or reset) in the packed vectors
+		struct PackedSlot {
+			std::string name;
+			size_t offset;
+			size_t width;
+			VHDLDataType dataType;
+		};
+		struct PackedLayout {
+			std::vector<PackedSlot> slots;
+			std::map<std::string, size_t> slotIdx;
+			size_t width = 0;
+
+			void add(std::string name, size_t width, VHDLDataType dataType);
+		};
+
 		VHDLExport &m_exporter;
 		std::fstream m_testbenchFile;
 		hlim::ClockRational m_writtenSimulationTime;
@@ -66,9 +89,18 @@ class FileBasedTestbenchRecorder : public BaseTestbenchRecorder
 		std::string m_testVectorFilename;
 		std::string m_vhdlFilename;
 
+		bool m_packedTestVectors;
+		PackedLayout m_packedChecks;
+		PackedLayout m_packedDrives;
+		utils::StableMap<const hlim::Clock*, size_t> m_packedClockIdx;
+		std::vector<bool> m_packedClockState;
+
 		void writeVHDL(std::filesystem::path path, const std::string &testVectorFilename);
+		void writeTextVectorReader(std::ostream &vhdlFile, const utils::StableMap<hlim::NodePort, bool> &outputIsBool, const utils::StableSet<hlim::NodePort> &outputIsDrivenByNetwork);
+		void writePackedVectorReader(std::ostream &vhdlFile);
+		void writePackedPhase(const Phase &phase, std::uint64_t advanceInPS);
 
-		void advanceTimeTo(const hlim::ClockRational &simulationTime);
+		std::uint64_t advanceTimeTo(const hlim::ClockRational &simulationTime);
 
 		// Flushes all actions and tests to file by spreading the accumulated phases out between flushIntervalEnd the last flushIntervalEnd to allow simulator progression (and result inspection) between phases.
 		void flush(const hlim::ClockRational &flushIntervalEnd);
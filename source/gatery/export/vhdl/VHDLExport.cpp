@@ -141,6 +141,9 @@ void VHDLExport::operator()(hlim::Circuit &circuit)
 	if (!m_destinationTestbench.empty())
 		std::filesystem::create_directories(m_destinationTestbench);
 
+	if (m_incremental)
+		m_manifest.load(getDestination() / ".gatery_export_manifest");
+
 	m_synthesisTool->prepareCircuit(circuit);
 
 	m_ast.reset(new AST(m_codeFormatting.get(), m_synthesisTool.get()));
@@ -148,13 +151,15 @@ void VHDLExport::operator()(hlim::Circuit &circuit)
 		m_ast->generateInterfacePackage(m_interfacePackageContent);
 
 	m_ast->convert((hlim::Circuit &)circuit);
-	m_ast->writeVHDL(m_destination, m_customVhdlFiles);
+	if (m_deduplicateEntities)
+		m_ast->deduplicateEntities();
+	m_ast->writeVHDL(m_destination, m_customVhdlFiles, m_manifest, m_numExportThreads);
 
 	for (auto &e : m_testbenchRecorderSettings) {
 		if (e.inlineTestData)
 			m_testbenchRecorder.push_back(std::make_unique<TestbenchRecorder>(*this, m_ast.get(), *e.simulator, m_destinationTestbench, e.name));
 		else
-			m_testbenchRecorder.push_back(std::make_unique<FileBasedTestbenchRecorder>(*this, m_ast.get(), *e.simulator, m_destinationTestbench, e.name));
+			m_testbenchRecorder.push_back(std::make_unique<FileBasedTestbenchRecorder>(*this, m_ast.get(), *e.simulator, m_destinationTestbench, e.name, m_packedTestVectors));
 			
 		e.simulator->addCallbacks(m_testbenchRecorder.back().get());
 	}
@@ -173,6 +178,8 @@ void VHDLExport::operator()(hlim::Circuit &circuit)
 
 	if (!m_instantiationTemplateVHDL.empty())
 		doWriteInstantiationTemplateVHDL(m_instantiationTemplateVHDL);
+
+	m_manifest.save();
 }
 
 bool VHDLExport::isSingleFileExport()
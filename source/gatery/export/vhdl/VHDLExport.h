@@ -24,6 +24,7 @@
 #include "AST.h"
 
 #include "InterfacePackage.h"
+#include "ExportManifest.h"
 
 #include "../../hlim/Circuit.h"
 
@@ -58,6 +59,14 @@ class VHDLExport
 		VHDLExport &writeProjectFile(std::string filename);
 		VHDLExport &writeStandAloneProjectFile(std::string filename);
 		VHDLExport &writeInstantiationTemplateVHDL(std::filesystem::path filename);
+		/// Formats and writes entities on multiple threads. The output is identical to the serial export. Zero uses all hardware threads.
+		VHDLExport &parallelExport(size_t numThreads = 0) { m_numExportThreads = numThreads; return *this; }
+		/// Keeps a manifest of content hashes next to the export and only rewrites files whose content changed.
+		VHDLExport &incrementalExport(bool incremental = true) { m_incremental = incremental; return *this; }
+		/// Test vector files of (not inlined) testbench recorders store one bit packed, hex encoded record per phase instead of one line per value.
+		VHDLExport &packedTestVectors(bool packed = true) { m_packedTestVectors = packed; return *this; }
+		/// Writes entities that are replicated identically (e.g. the lanes of a replicated datapath) only once and instantiates the shared entity instead.
+		VHDLExport &deduplicateEntities(bool deduplicate = true) { m_deduplicateEntities = deduplicate; return *this; }
 		CodeFormatting *getFormatting();
 
 		VHDLExport& setLibrary(std::string name) { m_library = std::move(name); return *this; }
@@ -65,6 +74,10 @@ class VHDLExport
 
 		void operator()(hlim::Circuit &circuit);
 
+		/// Writes a file of the export, skipping it if unchanged in incremental mode.
+		void writeFile(const std::filesystem::path &filename, std::string_view content) { m_manifest.writeFile(filename, content); }
+		const ExportManifest &getManifest() const { return m_manifest; }
+
 		AST *getAST() { return m_ast.get(); }
 		std::filesystem::path getDestination();
 		const std::filesystem::path &getTestbenchDestination() { return m_destinationTestbench; }
@@ -98,6 +111,11 @@ class VHDLExport
 		std::string m_constraintsFilename;
 		std::string m_clocksFilename;
 		std::filesystem::path m_instantiationTemplateVHDL;
+		size_t m_numExportThreads = 1;
+		bool m_incremental = false;
+		bool m_packedTestVectors = false;
+		bool m_deduplicateEntities = false;
+		ExportManifest m_manifest;
 
 		struct TestbenchRecorderSettings {
 			sim::Simulator *simulator;
@@ -23,6 +23,7 @@
 
 
 #include <gatery/export/DotExport.h>
+#include <gatery/hlim/Subnet.h>
 
 namespace gtry {
 
@@ -86,6 +87,13 @@ namespace gtry {
 
 	void DesignScope::postprocess() 
 	{
-		m_circuit.postprocess(hlim::DefaultPostprocessing{m_targetTech->getTechnologyMapping()});
+		m_circuit.postprocess(hlim::DefaultPostprocessing{m_targetTech->getTechnologyMapping(), m_targetTech->getTechCaps().getCap<TimingCapabilities>().getTimingModel()});
+	}
+
+	hlim::TimingAnalysis DesignScope::analyzeTiming(size_t numPathsPerClock)
+	{
+		hlim::TimingAnalysis analysis(m_targetTech->getTechCaps().getCap<TimingCapabilities>().getTimingModel());
+		analysis.analyze(hlim::Subnet::all(m_circuit), numPathsPerClock);
+		return analysis;
 	}
 }
@@ -20,6 +20,7 @@
 #include "Comments.h"
 #include <gatery/hlim/NodeGroup.h>
 #include <gatery/hlim/Circuit.h>
+#include <gatery/hlim/TimingAnalysis.h>
 #include <gatery/utils/Preprocessor.h>
 #include <gatery/simulation/ConstructionTimeSimulationContext.h>
 
@@ -58,6 +59,7 @@ class DesignScope : public BaseScope<DesignScope>
 		static DesignScope *get() { return m_currentScope; }
 		hlim::Circuit &getCircuit() { return m_circuit; }
 		const hlim::Circuit &getCircuit() const { return m_circuit; }
+		const sim::ConstructionTimeSimulationContext &getConstructionTimeSimContext() const { return m_simContext; }
 		
 		template<typename NodeType, typename... Args>
 		static NodeType *createNode(Args&&... args);		
@@ -73,6 +75,9 @@ class DesignScope : public BaseScope<DesignScope>
 
 		/// Runs postprocessing (including technology mapping) in the created design.
 		void postprocess();
+
+		/// Estimates the timing of the design with the delay tables of the target technology and extracts the most critical paths of each clock domain.
+		hlim::TimingAnalysis analyzeTiming(size_t numPathsPerClock = 10);
 	protected:
 		hlim::Circuit m_circuit;
 		GroupScope m_rootScope;
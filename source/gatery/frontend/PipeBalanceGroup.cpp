@@ -42,6 +42,12 @@ void PipeBalanceGroup::verifyConsistentEnableScope()
 	}
 }
 
+void PipeBalanceGroup::autoPipeline(size_t latencyBudget, std::optional<hlim::ClockRational> targetFrequency)
+{
+	HCL_DESIGNCHECK_HINT(!m_regSpawner->wasResolved(), "This pipeBalanceGroup has already been involved and resolved in retiming and can no longer be modified!");
+	m_regSpawner->setAutoPipelining({.latencyBudget = latencyBudget, .targetFrequency = targetFrequency});
+}
+
 size_t PipeBalanceGroup::getNumPipeBalanceGroupStages() const
 { 
 	HCL_DESIGNCHECK_HINT(m_regSpawner->wasResolved(), "The number of pipeline stages can only be queries after the retiming, at least on the part of the graph that is affected, has been performed!");
@@ -55,6 +55,14 @@ namespace gtry {
 			PipeBalanceGroup();
 
 			size_t getNumPipeBalanceGroupStages() const;
+			/**
+			 * @brief Lets the postprocessing pick the number and location of the pipeline stages based on the timing estimates of the target technology.
+			 * @details Stages are placed on the critical paths downstream of the group until every stage meets the target frequency or the latency budget is used up.
+			 * All signals of the group receive the same number of stages.
+			 * @param latencyBudget Maximum number of stages to insert (including stages placed through pipestage hints).
+			 * @param targetFrequency Frequency to meet, defaults to the frequency of the group's clock.
+			 */
+			void autoPipeline(size_t latencyBudget, std::optional<hlim::ClockRational> targetFrequency = {});
 			inline hlim::Node_RegSpawner *getRegSpawner() { return m_regSpawner.get(); }
 			void verifyConsistentEnableScope();
 		protected:
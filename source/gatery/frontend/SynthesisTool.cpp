@@ -161,8 +161,7 @@ void DefaultSynthesisTool::resolveAttributes(const hlim::MemoryAttributes &attri
 
 void DefaultSynthesisTool::writeConstraintFile(vhdl::VHDLExport &vhdlExport, const hlim::Circuit &circuit, std::string_view filename)
 {
-	std::fstream file((vhdlExport.getDestination() / filename).string().c_str(), std::fstream::out);
-	file.exceptions(std::fstream::failbit | std::fstream::badbit);
+	std::stringstream file;
 
 	file << "# List of constraints:" << std::endl;
 
@@ -177,12 +176,13 @@ void DefaultSynthesisTool::writeConstraintFile(vhdl::VHDLExport &vhdlExport, con
 
 		writeUserDefinedPathAttributes(file, attribs, start, end);
 	});
+
+	vhdlExport.writeFile(vhdlExport.getDestination() / filename, file.str());
 }
 
 void DefaultSynthesisTool::writeClocksFile(vhdl::VHDLExport &vhdlExport, const hlim::Circuit &circuit, std::string_view filename)
 {
-	std::fstream file((vhdlExport.getDestination() / filename).string().c_str(), std::fstream::out);
-	file.exceptions(std::fstream::failbit | std::fstream::badbit);
+	std::stringstream file;
 
 	file << "# List of clocks:" << std::endl;
 
@@ -194,12 +194,13 @@ void DefaultSynthesisTool::writeClocksFile(vhdl::VHDLExport &vhdlExport, const h
 
 		file << "clock: " << name << " period " << std::fixed << std::setprecision(3) << ns << " ns\n";
 	}
+
+	vhdlExport.writeFile(vhdlExport.getDestination() / filename, file.str());
 }
 
 void DefaultSynthesisTool::writeVhdlProjectScript(vhdl::VHDLExport &vhdlExport, std::string_view filename)
 {
-	std::fstream file((vhdlExport.getDestination() / filename).string().c_str(), std::fstream::out);
-	file.exceptions(std::fstream::failbit | std::fstream::badbit);
+	std::stringstream file;
 
 	file << "# List of source files in dependency order:" << std::endl;
 
@@ -232,6 +233,8 @@ void DefaultSynthesisTool::writeVhdlProjectScript(vhdl::VHDLExport &vhdlExport,
 		file << vhdlExport.getConstraintsFilename() << std::endl;
 	if (!vhdlExport.getClocksFilename().empty())
 		file << vhdlExport.getClocksFilename() << std::endl;
+
+	vhdlExport.writeFile(vhdlExport.getDestination() / filename, file.str());
 }
 
 void DefaultSynthesisTool::writeStandAloneProject(vhdl::VHDLExport& vhdlExport, std::string_view filename)
@@ -22,6 +22,10 @@
 
 namespace gtry {
 
+TargetTechnology::TargetTechnology()
+{
+	m_techCaps.registerCap(&m_timingCaps);
+}
 
 DefaultTargetTechnology::DefaultTargetTechnology()
 {
@@ -26,6 +26,7 @@ namespace gtry {
 
 class TargetTechnology {
 	public:
+		TargetTechnology();
 		virtual ~TargetTechnology() = default;
 
 		inline const hlim::TechnologyMapping &getTechnologyMapping() const { return m_technologyMapping; }
@@ -33,6 +34,7 @@ class TargetTechnology {
 		TechnologyScope enterTechScope() { return TechnologyScope(m_techCaps); }
 	protected:
 		TechnologyCapabilities m_techCaps;
+		TimingCapabilities m_timingCaps;
 		hlim::TechnologyMapping m_technologyMapping;
 };
 
@@ -20,6 +20,7 @@
 #include "../Scope.h"
 
 #include <gatery/utils/BitFlags.h>
+#include <gatery/hlim/TimingModel.h>
 
 namespace gtry {
 
@@ -166,6 +167,17 @@ class FifoCapabilities : public Capabilities {
 	protected:
 };
 
+class TimingCapabilities : public Capabilities {
+	public:
+		/// Delay figures of the target device used for timing estimates.
+		inline const hlim::TimingModel &getTimingModel() const { return m_timingModel; }
+		inline void setTimingModel(const hlim::TimingModel &timingModel) { m_timingModel = timingModel; }
+
+		static const char *getName() { return "timing"; }
+	protected:
+		hlim::TimingModel m_timingModel;
+};
+
 class TechnologyCapabilities {
 	public:
 		template<class Cap>
@@ -71,6 +71,15 @@
 
 namespace gtry::hlim {
 
+void NodeDeleter::operator()(BaseNode *node) const
+{
+	if (allocator != nullptr) {
+		node->~BaseNode();
+		allocator->deallocate(node);
+	} else
+		delete node;
+}
+
 Circuit::Circuit()
 {
 #ifdef _DEBUG
@@ -166,9 +175,18 @@ void Circuit::copySubnet(const utils::StableSet<NodePort> &subnetInputs,
 }
 
 
+utils::SlabAllocator &Circuit::getNodeAllocator(std::type_index nodeType, size_t size, size_t alignment)
+{
+	auto &allocator = m_nodeAllocators[nodeType];
+	if (allocator == nullptr)
+		allocator = std::make_unique<utils::SlabAllocator>(size, alignment);
+	return *allocator;
+}
+
 BaseNode *Circuit::createUnconnectedClone(BaseNode *srcNode, bool noId)
 {
-	m_nodes.push_back(srcNode->cloneUnconnected());
+	// Clones are created by the nodes themselves and thus not allocated from the slabs.
+	m_nodes.push_back(OwnedNodePtr(srcNode->cloneUnconnected().release()));
 	if (!noId)
 		m_nodes.back()->setId(m_nextNodeId++, {});
 	return m_nodes.back().get();
@@ -1269,23 +1287,28 @@ void Circuit::postprocess(const PostProcessor &postProcessor)
 	dbg::changeState(dbg::State::POSTPROCESS);
 	postProcessor.run(*this);
 
-	detectUnguardedCDCCrossings(*this, ConstSubnet::all(*this), [this](const BaseNode *affectedNode) {
-		dbg::log(dbg::LogMessage() << dbg::LogMessage::LOG_ERROR << dbg::LogMessage::LOG_POSTPROCESSING 
-				<< "Unintentional clock domain crossing detected at node " << affectedNode
-		);
-		visualize(*this, "CDC_full");
+	auto cdcViolations = findUnguardedCDCCrossings(*this, ConstSubnet::all(*this));
+	if (!cdcViolations.empty()) {
+		std::stringstream msg;
+		msg << cdcViolations.size() << " unintentional clock domain crossing(s) detected:";
 
 		ConstSubnet net;
-		net.add(affectedNode); 
-		for(size_t i=0; i< 10; i++)
-			net.dilate(false, true);
-		
+		for (auto affectedNode : cdcViolations) {
+			dbg::log(dbg::LogMessage() << dbg::LogMessage::LOG_ERROR << dbg::LogMessage::LOG_POSTPROCESSING 
+					<< "Unintentional clock domain crossing detected at node " << affectedNode
+			);
+			for (auto n : extractNeighborhood(affectedNode, 10))
+				net.add(n);
+
+			msg << "\nAt node: " << affectedNode->getName() << " " << affectedNode->getTypeName() << " (" << affectedNode->getId() << " ) from:"
+				<< affectedNode->getStackTrace();
+		}
+
+		visualize(*this, "CDC_full");
 		visualize(*this, "CDC_partial", net);
-		std::stringstream msg;
-		msg << "Unintentional clock domain crossing detected at node: " << affectedNode->getName() << " " << affectedNode->getTypeName() << " (" << affectedNode->getId() << " ) from:"
-			<< affectedNode->getStackTrace();
+
 		HCL_DESIGNCHECK_HINT(false, msg.str());
-	});
+	}
 
 }
 
@@ -1324,7 +1347,7 @@ void DefaultPostprocessing::generalOptimization(Circuit &circuit) const
 */
 
 	subnet = Subnet::all(circuit);
-	resolveRetimingHints(circuit, subnet);
+	resolveRetimingHints(circuit, subnet, m_timingModel);
 	bypassRetimingBlockers(circuit, subnet);
 /*
 	{
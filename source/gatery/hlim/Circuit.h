@@ -23,11 +23,17 @@
 #include "../simulation/SimulationVisualization.h"
 
 #include "../utils/CppTools.h"
+#include "../utils/SlabAllocator.h"
 
+#include "TimingModel.h"
+
+#include <filesystem>
+#include <iosfwd>
 #include <vector>
 #include <memory>
 #include <map>
 #include <functional>
+#include <typeindex>
 
 namespace gtry::hlim {
 
@@ -44,6 +50,13 @@ namespace gtry::hlim {
 	class Node_Signal;
 	class Node_Attributes;
 
+	/// Destroys nodes that were allocated from a slab allocator of the circuit, or through delete if no allocator is set.
+	struct NodeDeleter {
+		utils::SlabAllocator *allocator = nullptr;
+		void operator()(BaseNode *node) const;
+	};
+	using OwnedNodePtr = std::unique_ptr<BaseNode, NodeDeleter>;
+
 	/*
 	class Circuit;
 	class Report;
@@ -76,6 +89,12 @@ namespace gtry::hlim {
 	*/
 
 
+	/// Selects which optional sections are written into a circuit snapshot.
+	struct CircuitSnapshotOptions {
+		/// Node names and comments. Without them, export and simulation still work but signals are unnamed.
+		bool names = true;
+	};
+
 	class PostProcessor {
 	public:
 		virtual void run(Circuit& circuit) const = 0;
@@ -88,9 +107,11 @@ namespace gtry::hlim {
 	public:
 		DefaultPostprocessing() { }
 		DefaultPostprocessing(const TechnologyMapping& techMapping) : m_techMapping(&techMapping) { }
+		DefaultPostprocessing(const TechnologyMapping& techMapping, const TimingModel& timingModel) : m_techMapping(&techMapping), m_timingModel(timingModel) { }
 		virtual void run(Circuit& circuit) const override;
 	protected:
 		const TechnologyMapping* m_techMapping = nullptr;
+		TimingModel m_timingModel;
 
 		void generalOptimization(Circuit& circuit) const;
 		void memoryDetection(Circuit& circuit) const;
@@ -135,8 +156,8 @@ namespace gtry::hlim {
 		inline NodeGroup* getRootNodeGroup() { return m_root.get(); }
 		inline const NodeGroup* getRootNodeGroup() const { return m_root.get(); }
 
-		inline std::vector<std::unique_ptr<BaseNode>>& getNodes() { return m_nodes; }
-		inline const std::vector<std::unique_ptr<BaseNode>>& getNodes() const { return m_nodes; }
+		inline std::vector<OwnedNodePtr>& getNodes() { return m_nodes; }
+		inline const std::vector<OwnedNodePtr>& getNodes() const { return m_nodes; }
 		inline const std::vector<std::unique_ptr<Clock>>& getClocks() const { return m_clocks; }
 
 		void inferSignalNames();
@@ -170,6 +191,17 @@ namespace gtry::hlim {
 		void optimizeSubnet(Subnet& subnet);
 		void postprocess(const PostProcessor& postProcessor);
 
+		/**
+		 * @brief Writes the netlist (nodes, connections, node groups, clocks, and attributes) into a compact binary snapshot.
+		 * @details Simulation processes and visualizations are code and thus not part of the snapshot.
+		 * Node types that wrap user code (external nodes and signal generators) can not be stored.
+		 */
+		void saveSnapshot(std::ostream &stream, const CircuitSnapshotOptions &options = {}) const;
+		void saveSnapshot(const std::filesystem::path &filename, const CircuitSnapshotOptions &options = {}) const;
+		/// Rebuilds a netlist written by saveSnapshot into this circuit, which must still be empty.
+		void loadSnapshot(std::istream &stream);
+		void loadSnapshot(const std::filesystem::path &filename);
+
 		Node_Signal* appendSignal(NodePort& nodePort);
 		Node_Signal* appendSignal(RefCtdNodePort& nodePort);
 
@@ -187,7 +219,9 @@ namespace gtry::hlim {
 		std::uint64_t allocateRevisitColor(utils::RestrictTo<RevisitCheck>);
 		void freeRevisitColor(std::uint64_t color, utils::RestrictTo<RevisitCheck>);
 	protected:
-		std::vector<std::unique_ptr<BaseNode>> m_nodes;
+		/// One slab allocator per node type, such that nodes of the same type are packed densely in memory. Must outlive m_nodes.
+		std::map<std::type_index, std::unique_ptr<utils::SlabAllocator>> m_nodeAllocators;
+		std::vector<OwnedNodePtr> m_nodes;
 		std::unique_ptr<NodeGroup> m_root;
 		std::vector<std::unique_ptr<SignalGroup>> m_signalGroups;
 		std::vector<std::unique_ptr<Clock>> m_clocks;
@@ -204,6 +238,7 @@ namespace gtry::hlim {
 
 		std::vector<size_t> m_debugNodeId;
 
+		utils::SlabAllocator &getNodeAllocator(std::type_index nodeType, size_t size, size_t alignment);
 		void setNodeId(BaseNode* node);
 		void setClockId(Clock* clock);
 		void readDebugNodeIds();
@@ -212,9 +247,19 @@ namespace gtry::hlim {
 
 	template<std::derived_from<BaseNode> NodeType, typename... Args>
 	NodeType* Circuit::createNode(Args&&... args) {
-		m_nodes.push_back(std::make_unique<NodeType>(std::forward<Args>(args)...));
-		setNodeId(m_nodes.back().get());
-		return (NodeType*)m_nodes.back().get();
+		utils::SlabAllocator &allocator = getNodeAllocator(typeid(NodeType), sizeof(NodeType), alignof(NodeType));
+		void *memory = allocator.allocate();
+		NodeType *node;
+		try {
+			node = new (memory) NodeType(std::forward<Args>(args)...);
+		} catch (...) {
+			allocator.deallocate(memory);
+			throw;
+		}
+		OwnedNodePtr nodePtr(node, NodeDeleter{ .allocator = &allocator });
+		m_nodes.push_back(std::move(nodePtr));
+		setNodeId(node);
+		return node;
 	}
 
 	template<typename ClockType, typename... Args>
@@ -0,0 +1,824 @@
+/*  This file is part of Gatery, a library for circuit design.
+	Copyright (C) 2021 Michael Offel, Andreas Ley
+
+	Gatery is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	Gatery is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#include "gatery/pch.h"
+#include "Circuit.h"
+
+#include "NodeGroup.h"
+#include "Node.h"
+#include "Clock.h"
+#include "coreNodes/Node_Arithmetic.h"
+#include "coreNodes/Node_Clk2Signal.h"
+#include "coreNodes/Node_ClkRst2Signal.h"
+#include "coreNodes/Node_Compare.h"
+#include "coreNodes/Node_Constant.h"
+#include "coreNodes/Node_Logic.h"
+#include "coreNodes/Node_MultiDriver.h"
+#include "coreNodes/Node_Multiplexer.h"
+#include "coreNodes/Node_Pin.h"
+#include "coreNodes/Node_PriorityConditional.h"
+#include "coreNodes/Node_Register.h"
+#include "coreNodes/Node_Rewire.h"
+#include "coreNodes/Node_Shift.h"
+#include "coreNodes/Node_Signal.h"
+#include "coreNodes/Node_Signal2Clk.h"
+#include "coreNodes/Node_Signal2Rst.h"
+
+#include "supportNodes/Node_Attributes.h"
+#include "supportNodes/Node_CDC.h"
+#include "supportNodes/Node_Default.h"
+#include "supportNodes/Node_ExportOverride.h"
+#include "supportNodes/Node_External.h"
+#include "supportNodes/Node_MemPort.h"
+#include "supportNodes/Node_Memory.h"
+#include "supportNodes/Node_PathAttributes.h"
+#include "supportNodes/Node_RegHint.h"
+#include "supportNodes/Node_RegSpawner.h"
+#include "supportNodes/Node_RetimingBlocker.h"
+#include "supportNodes/Node_SignalGenerator.h"
+#include "supportNodes/Node_SignalTap.h"
+
+#include "../simulation/BitVectorState.h"
+#include "../utils/Range.h"
+
+#include <fstream>
+
+/*
+	Snapshot layout (all integers are LEB128 encoded):
+
+	header      magic, format version, section flags
+	clocks      in creation order, parents always precede derived clocks
+	groups      node group hierarchy in pre-order, the root group is implicit
+	nodes       in id order: type tag, group, port and clock layout, output types, type specific parameters
+	connections the driver of every input of every node
+	drivers     the logic drivers bound to each clock
+	names       (optional) node names and comments
+*/
+
+namespace gtry::hlim {
+
+namespace {
+
+const char SNAPSHOT_MAGIC[8] = { 'G', 'T', 'R', 'Y', 'S', 'N', 'A', 'P' };
+/// Must be incremented on any change to the layout, old snapshots are rejected rather than misinterpreted.
+const std::uint64_t SNAPSHOT_VERSION = 1;
+
+enum SnapshotSections {
+	SECTION_NAMES = 1 << 0,
+};
+
+enum class NodeTag : std::uint8_t {
+	ARITHMETIC,
+	SIGNAL2CLK,
+	SIGNAL2RST,
+	CLK2SIGNAL,
+	CLKRST2SIGNAL,
+	COMPARE,
+	CONSTANT,
+	LOGIC,
+	MULTIPLEXER,
+	PIN,
+	PRIORITY_CONDITIONAL,
+	REGISTER,
+	REWIRE,
+	SHIFT,
+	SIGNAL,
+	SIGNAL_TAP,
+	MEMORY,
+	MEM_PORT,
+	DEFAULT,
+	EXPORT_OVERRIDE,
+	ATTRIBUTES,
+	PATH_ATTRIBUTES,
+	REG_SPAWNER,
+	REG_HINT,
+	CDC,
+	MULTI_DRIVER,
+	RETIMING_BLOCKER,
+	COUNT
+};
+
+class SnapshotWriter {
+	public:
+		SnapshotWriter(std::ostream &stream) : m_stream(stream) { }
+
+		void number(std::uint64_t value) {
+			do {
+				std::uint8_t byte = value & 0x7F;
+				value >>= 7;
+				if (value) byte |= 0x80;
+				m_stream.put((char) byte);
+			} while (value);
+		}
+
+		void boolean(bool value) { number(value ? 1 : 0); }
+
+		void string(std::string_view str) {
+			number(str.size());
+			m_stream.write(str.data(), str.size());
+		}
+
+		void rational(const ClockRational &value) {
+			number(value.numerator());
+			number(value.denominator());
+		}
+
+		void state(const sim::DefaultBitVectorState &state) {
+			number(state.size());
+			for (auto plane : { sim::DefaultConfig::VALUE, sim::DefaultConfig::DEFINED })
+				for (auto i : utils::Range(state.getNumBlocks()))
+					number(state.data(plane)[i]);
+		}
+
+		void connectionType(const ConnectionType &type) {
+			number(type.type);
+			number(type.width);
+		}
+
+		void attributes(const Attributes &attribs) {
+			number(attribs.userDefinedVendorAttributes.size());
+			for (const auto &[vendor, vendorAttribs] : attribs.userDefinedVendorAttributes) {
+				string(vendor);
+				number(vendorAttribs.size());
+				for (const auto &[name, value] : vendorAttribs) {
+					string(name);
+					string(value.type);
+					string(value.value);
+				}
+			}
+		}
+	protected:
+		std::ostream &m_stream;
+};
+
+class SnapshotReader {
+	public:
+		SnapshotReader(std::istream &stream) : m_stream(stream) { }
+
+		std::uint64_t number() {
+			std::uint64_t value = 0;
+			for (unsigned shift = 0; ; shift += 7) {
+				int byte = m_stream.get();
+				HCL_DESIGNCHECK_HINT(byte != std::char_traits<char>::eof() && shift < 64, "The circuit snapshot is truncated or corrupted!");
+				value |= std::uint64_t(byte & 0x7F) << shift;
+				if (!(byte & 0x80)) return value;
+			}
+		}
+
+		template<typename Enum>
+		Enum enumeration(Enum count) {
+			auto value = number();
+			HCL_DESIGNCHECK_HINT(value < (std::uint64_t) count, "The circuit snapshot is corrupted!");
+			return (Enum) value;
+		}
+
+		/// Reads a 1-based index into a list of size count, where zero encodes nullptr.
+		template<typename Type>
+		Type *reference(const std::vector<Type*> &list) {
+			auto idx = number();
+			if (idx == 0) return nullptr;
+			HCL_DESIGNCHECK_HINT(idx <= list.size(), "The circuit snapshot is corrupted!");
+			return list[idx-1];
+		}
+
+		bool boolean() { return number() != 0; }
+
+		std::string string() {
+			std::string str(number(), '\0');
+			m_stream.read(str.data(), str.size());
+			HCL_DESIGNCHECK_HINT(m_stream.good(), "The circuit snapshot is truncated or corrupted!");
+			return str;
+		}
+
+		ClockRational rational() {
+			auto numerator = number();
+			auto denominator = number();
+			HCL_DESIGNCHECK_HINT(denominator != 0, "The circuit snapshot is corrupted!");
+			return ClockRational(numerator, denominator);
+		}
+
+		sim::DefaultBitVectorState state() {
+			sim::DefaultBitVectorState state;
+			state.resize(number());
+			for (auto plane : { sim::DefaultConfig::VALUE, sim::DefaultConfig::DEFINED })
+				for (auto i : utils::Range(state.getNumBlocks()))
+					state.data(plane)[i] = number();
+			return state;
+		}
+
+		ConnectionType connectionType() {
+			ConnectionType type;
+			type.type = enumeration(ConnectionType::Type(ConnectionType::DEPENDENCY + 1));
+			type.width = number();
+			return type;
+		}
+
+		void attributes(Attributes &attribs) {
+			for ([[maybe_unused]] auto i : utils::Range(number())) {
+				auto &vendorAttribs = attribs.userDefinedVendorAttributes[string()];
+				for ([[maybe_unused]] auto j : utils::Range(number())) {
+					auto &value = vendorAttribs[string()];
+					value.type = string();
+					value.value = string();
+				}
+			}
+		}
+	protected:
+		std::istream &m_stream;
+};
+
+/// Writes the type tag followed by everything that is not part of the generic port and clock layout.
+class NodePayloadWriter : public ConstNodeVisitor
+{
+	public:
+		NodePayloadWriter(SnapshotWriter &writer) : m_writer(writer) { }
+
+		virtual void operator()(const Node_Arithmetic &node) override { tag(NodeTag::ARITHMETIC); m_writer.number(node.getOp()); }
+		virtual void operator()(const Node_Signal2Clk &node) override { tag(NodeTag::SIGNAL2CLK); }
+		virtual void operator()(const Node_Signal2Rst &node) override { tag(NodeTag::SIGNAL2RST); }
+		virtual void operator()(const Node_Clk2Signal &node) override { tag(NodeTag::CLK2SIGNAL); }
+		virtual void operator()(const Node_ClkRst2Signal &node) override { tag(NodeTag::CLKRST2SIGNAL); }
+		virtual void operator()(const Node_Compare &node) override { tag(NodeTag::COMPARE); m_writer.number(node.getOp()); }
+		virtual void operator()(const Node_Constant &node) override { tag(NodeTag::CONSTANT); m_writer.state(node.getValue()); }
+		virtual void operator()(const Node_External &node) override { unsupported(node); }
+		virtual void operator()(const Node_Logic &node) override { tag(NodeTag::LOGIC); m_writer.number(node.getOp()); }
+		virtual void operator()(const Node_Multiplexer &node) override { tag(NodeTag::MULTIPLEXER); m_writer.number(node.getConditionId()); }
+		virtual void operator()(const Node_Pin &node) override {
+			tag(NodeTag::PIN);
+			m_writer.boolean(node.isInputPin());
+			m_writer.boolean(node.isOutputPin());
+			m_writer.boolean(node.hasOutputEnable());
+			m_writer.connectionType(node.getConnectionType());
+			m_writer.boolean(node.isDifferential());
+			if (node.isDifferential()) {
+				m_writer.string(node.getDifferentialPosName());
+				m_writer.string(node.getDifferentialNegName());
+			}
+		}
+		virtual void operator()(const Node_PriorityConditional &node) override { tag(NodeTag::PRIORITY_CONDITIONAL); }
+		virtual void operator()(const Node_Register &node) override {
+			tag(NodeTag::REGISTER);
+			for (auto flag : { Node_Register::Flags::ALLOW_RETIMING_FORWARD, Node_Register::Flags::ALLOW_RETIMING_BACKWARD, Node_Register::Flags::IS_BOUND_TO_MEMORY })
+				m_writer.boolean(node.getFlags().contains(flag));
+		}
+		virtual void operator()(const Node_Rewire &node) override {
+			tag(NodeTag::REWIRE);
+			const auto &ranges = node.getOp().ranges;
+			m_writer.number(ranges.size());
+			for (const auto &range : ranges) {
+				m_writer.number(range.subwidth);
+				m_writer.number(range.source);
+				m_writer.number(range.inputIdx);
+				m_writer.number(range.inputOffset);
+			}
+		}
+		virtual void operator()(const Node_Shift &node) override {
+			tag(NodeTag::SHIFT);
+			m_writer.number((std::uint64_t) node.getDirection());
+			m_writer.number((std::uint64_t) node.getFillMode());
+		}
+		virtual void operator()(const Node_Signal &node) override { tag(NodeTag::SIGNAL); }
+		virtual void operator()(const Node_SignalGenerator &node) override { unsupported(node); }
+		virtual void operator()(const Node_SignalTap &node) override {
+			tag(NodeTag::SIGNAL_TAP);
+			m_writer.number(node.getLevel());
+			m_writer.number(node.getTrigger());
+			m_writer.number(node.getMessageParts().size());
+			for (const auto &part : node.getMessageParts()) {
+				if (const auto *str = boost::get<std::string>(&part)) {
+					m_writer.number(0);
+					m_writer.string(*str);
+				} else {
+					const auto &signal = boost::get<Node_SignalTap::FormattedSignal>(part);
+					m_writer.number(1);
+					m_writer.number(signal.inputIdx);
+					m_writer.number(signal.format);
+				}
+			}
+		}
+		virtual void operator()(const Node_Memory &node) override {
+			tag(NodeTag::MEMORY);
+			m_writer.number((std::uint64_t) node.type());
+			m_writer.number(node.getRequiredReadLatency());
+			m_writer.number(node.getInitializationDataWidth());
+			m_writer.state(node.getPowerOnState());
+			m_writer.attributes(node.getAttribs());
+			m_writer.boolean(node.getAttribs().noConflicts);
+			m_writer.boolean(node.getAttribs().arbitraryPortRetiming);
+		}
+		virtual void operator()(const Node_MemPort &node) override { tag(NodeTag::MEM_PORT); m_writer.number(node.getBitWidth()); }
+		virtual void operator()(const Node_Default &node) override { tag(NodeTag::DEFAULT); }
+		virtual void operator()(const Node_ExportOverride &node) override { tag(NodeTag::EXPORT_OVERRIDE); }
+		virtual void operator()(const Node_Attributes &node) override {
+			tag(NodeTag::ATTRIBUTES);
+			const auto &attribs = node.getAttribs();
+			m_writer.attributes(attribs);
+			m_writer.boolean(attribs.maxFanout.has_value());
+			if (attribs.maxFanout)
+				m_writer.number(*attribs.maxFanout);
+			m_writer.boolean(attribs.allowFusing.has_value());
+			if (attribs.allowFusing)
+				m_writer.boolean(*attribs.allowFusing);
+		}
+		virtual void operator()(const Node_PathAttributes &node) override {
+			tag(NodeTag::PATH_ATTRIBUTES);
+			const auto &attribs = node.getAttribs();
+			m_writer.attributes(attribs);
+			m_writer.number(attribs.multiCycle);
+			m_writer.boolean(attribs.falsePath);
+		}
+		virtual void operator()(const Node_RegSpawner &node) override {
+			tag(NodeTag::REG_SPAWNER);
+			m_writer.boolean(node.wasResolved());
+			const auto &autoPipelining = node.getAutoPipelining();
+			m_writer.boolean(autoPipelining.has_value());
+			if (autoPipelining) {
+				m_writer.number(autoPipelining->latencyBudget);
+				m_writer.boolean(autoPipelining->targetFrequency.has_value());
+				if (autoPipelining->targetFrequency)
+					m_writer.rational(*autoPipelining->targetFrequency);
+			}
+		}
+		virtual void operator()(const Node_RegHint &node) override { tag(NodeTag::REG_HINT); }
+		virtual void operator()(const Node_CDC &node) override { tag(NodeTag::CDC); }
+		virtual void operator()(const Node_MultiDriver &node) override { tag(NodeTag::MULTI_DRIVER); }
+		virtual void operator()(const Node_RetimingBlocker &node) override { tag(NodeTag::RETIMING_BLOCKER); }
+	protected:
+		SnapshotWriter &m_writer;
+
+		void tag(NodeTag tag) { m_writer.number((std::uint64_t) tag); }
+		void unsupported(const BaseNode &node) {
+			HCL_DESIGNCHECK_HINT(false, "Nodes of type " + node.getTypeName() + " (" + node.getName() + ") wrap user code and can not be stored in a circuit snapshot!");
+		}
+};
+
+template<std::derived_from<BaseNode> NodeType, typename... Args>
+NodeType *createInGroup(Circuit &circuit, NodeGroup *group, Args&&... args)
+{
+	NodeType *node = circuit.createNode<NodeType>(std::forward<Args>(args)...);
+	node->moveToGroup(group);
+	return node;
+}
+
+/**
+ * @brief Creates a node of the given type in the given group and restores everything written by NodePayloadWriter.
+ * @param resolvedSpawners Receives register spawners that need to be marked as resolved once they are connected.
+ */
+BaseNode *createNodeFromPayload(Circuit &circuit, NodeGroup *group, SnapshotReader &reader, NodeTag tag, size_t numInputs, const std::vector<ConnectionType> &outputTypes, std::vector<Node_RegSpawner*> &resolvedSpawners)
+{
+	switch (tag) {
+		case NodeTag::ARITHMETIC:
+			return createInGroup<Node_Arithmetic>(circuit, group, reader.enumeration(Node_Arithmetic::Op(Node_Arithmetic::REM + 1)));
+		case NodeTag::SIGNAL2CLK:
+			return createInGroup<Node_Signal2Clk>(circuit, group);
+		case NodeTag::SIGNAL2RST:
+			return createInGroup<Node_Signal2Rst>(circuit, group);
+		case NodeTag::CLK2SIGNAL:
+			return createInGroup<Node_Clk2Signal>(circuit, group);
+		case NodeTag::CLKRST2SIGNAL:
+			return createInGroup<Node_ClkRst2Signal>(circuit, group);
+		case NodeTag::COMPARE:
+			return createInGroup<Node_Compare>(circuit, group, reader.enumeration(Node_Compare::Op(Node_Compare::GEQ + 1)));
+		case NodeTag::CONSTANT: {
+			HCL_DESIGNCHECK_HINT(outputTypes.size() == 1, "The circuit snapshot is corrupted!");
+			auto value = reader.state();
+			return createInGroup<Node_Constant>(circuit, group, std::move(value), outputTypes[0]);
+		}
+		case NodeTag::LOGIC:
+			return createInGroup<Node_Logic>(circuit, group, reader.enumeration(Node_Logic::Op(Node_Logic::NOT + 1)));
+		case NodeTag::MULTIPLEXER: {
+			HCL_DESIGNCHECK_HINT(numInputs >= 1, "The circuit snapshot is corrupted!");
+			auto *mux = createInGroup<Node_Multiplexer>(circuit, group, numInputs-1);
+			mux->setConditionId(reader.number());
+			return mux;
+		}
+		case NodeTag::PIN: {
+			bool inputPin = reader.boolean();
+			bool outputPin = reader.boolean();
+			bool hasOutputEnable = reader.boolean();
+			auto *pin = createInGroup<Node_Pin>(circuit, group, inputPin, outputPin, hasOutputEnable);
+			auto connectionType = reader.connectionType();
+			if (inputPin) {
+				if (connectionType.isBool())
+					pin->setBool();
+				else
+					pin->setWidth(connectionType.width);
+			}
+			if (reader.boolean()) {
+				// The differential names are derived from the pin name at the time they are set, so set them while the pin is still unnamed.
+				auto posName = reader.string();
+				auto negName = reader.string();
+				pin->setDifferential(posName, negName);
+			}
+			return pin;
+		}
+		case NodeTag::PRIORITY_CONDITIONAL:
+			return createInGroup<Node_PriorityConditional>(circuit, group);
+		case NodeTag::REGISTER: {
+			auto *reg = createInGroup<Node_Register>(circuit, group);
+			for (auto flag : { Node_Register::Flags::ALLOW_RETIMING_FORWARD, Node_Register::Flags::ALLOW_RETIMING_BACKWARD, Node_Register::Flags::IS_BOUND_TO_MEMORY })
+				if (reader.boolean())
+					reg->getFlags().insert(flag);
+				else
+					reg->getFlags().clear(flag);
+			return reg;
+		}
+		case NodeTag::REWIRE: {
+			HCL_DESIGNCHECK_HINT(outputTypes.size() == 1, "The circuit snapshot is corrupted!");
+			auto *rewire = createInGroup<Node_Rewire>(circuit, group, numInputs);
+			Node_Rewire::RewireOperation op;
+			op.ranges.resize(reader.number());
+			for (auto &range : op.ranges) {
+				range.subwidth = reader.number();
+				range.source = reader.enumeration(Node_Rewire::OutputRange::Source(Node_Rewire::OutputRange::CONST_ONE + 1));
+				range.inputIdx = reader.number();
+				range.inputOffset = reader.number();
+			}
+			rewire->changeOutputType(outputTypes[0]);
+			rewire->setOp(std::move(op));
+			return rewire;
+		}
+		case NodeTag::SHIFT: {
+			auto direction = reader.enumeration(Node_Shift::dir(size_t(Node_Shift::dir::right) + 1));
+			auto fill = reader.enumeration(Node_Shift::fill(size_t(Node_Shift::fill::rotate) + 1));
+			return createInGroup<Node_Shift>(circuit, group, direction, fill);
+		}
+		case NodeTag::SIGNAL:
+			return createInGroup<Node_Signal>(circuit, group);
+		case NodeTag::SIGNAL_TAP: {
+			auto *tap = createInGroup<Node_SignalTap>(circuit, group);
+			tap->setLevel(reader.enumeration(Node_SignalTap::Level(Node_SignalTap::LVL_WATCH + 1)));
+			tap->setTrigger(reader.enumeration(Node_SignalTap::Trigger(Node_SignalTap::TRIG_FIRST_CLOCK + 1)));
+			for ([[maybe_unused]] auto i : utils::Range(reader.number())) {
+				if (reader.number() == 0)
+					tap->addMessagePart(reader.string());
+				else {
+					Node_SignalTap::FormattedSignal signal;
+					signal.inputIdx = (unsigned) reader.number();
+					signal.format = (unsigned) reader.number();
+					tap->addMessagePart(signal);
+				}
+			}
+			return tap;
+		}
+		case NodeTag::MEMORY: {
+			auto *memory = createInGroup<Node_Memory>(circuit, group);
+			auto type = reader.enumeration(Node_Memory::MemType(size_t(Node_Memory::MemType::EXTERNAL) + 1));
+			auto requiredReadLatency = reader.number();
+			auto initializationDataWidth = reader.number();
+			memory->setPowerOnState(reader.state());
+			memory->setInitializationNetDataWidth(initializationDataWidth);
+			if (requiredReadLatency != 0)
+				memory->setType(type, requiredReadLatency);
+			else
+				memory->setType(type);
+			reader.attributes(memory->getAttribs());
+			memory->getAttribs().noConflicts = reader.boolean();
+			memory->getAttribs().arbitraryPortRetiming = reader.boolean();
+			return memory;
+		}
+		case NodeTag::MEM_PORT:
+			return createInGroup<Node_MemPort>(circuit, group, reader.number());
+		case NodeTag::DEFAULT:
+			return createInGroup<Node_Default>(circuit, group);
+		case NodeTag::EXPORT_OVERRIDE:
+			return createInGroup<Node_ExportOverride>(circuit, group);
+		case NodeTag::ATTRIBUTES: {
+			auto *node = createInGroup<Node_Attributes>(circuit, group);
+			auto &attribs = node->getAttribs();
+			reader.attributes(attribs);
+			if (reader.boolean())
+				attribs.maxFanout = reader.number();
+			if (reader.boolean())
+				attribs.allowFusing = reader.boolean();
+			return node;
+		}
+		case NodeTag::PATH_ATTRIBUTES: {
+			auto *node = createInGroup<Node_PathAttributes>(circuit, group);
+			auto &attribs = node->getAttribs();
+			reader.attributes(attribs);
+			attribs.multiCycle = reader.number();
+			attribs.falsePath = reader.boolean();
+			return node;
+		}
+		case NodeTag::REG_SPAWNER: {
+			auto *spawner = createInGroup<Node_RegSpawner>(circuit, group);
+			if (reader.boolean())
+				resolvedSpawners.push_back(spawner);
+			if (reader.boolean()) {
+				Node_RegSpawner::AutoPipelining settings;
+				settings.latencyBudget = reader.number();
+				if (reader.boolean())
+					settings.targetFrequency = reader.rational();
+				spawner->setAutoPipelining(settings);
+			}
+			return spawner;
+		}
+		case NodeTag::REG_HINT:
+			return createInGroup<Node_RegHint>(circuit, group);
+		case NodeTag::CDC:
+			return createInGroup<Node_CDC>(circuit, group);
+		case NodeTag::MULTI_DRIVER:
+			HCL_DESIGNCHECK_HINT(outputTypes.size() == 1, "The circuit snapshot is corrupted!");
+			return createInGroup<Node_MultiDriver>(circuit, group, numInputs, outputTypes[0]);
+		case NodeTag::RETIMING_BLOCKER:
+			return createInGroup<Node_RetimingBlocker>(circuit, group);
+		default:
+			HCL_DESIGNCHECK_HINT(false, "The circuit snapshot is corrupted!");
+	}
+	return nullptr;
+}
+
+}
+
+void Circuit::saveSnapshot(std::ostream &stream, const CircuitSnapshotOptions &options) const
+{
+	SnapshotWriter writer(stream);
+
+	stream.write(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+	writer.number(SNAPSHOT_VERSION);
+	writer.number(options.names ? SECTION_NAMES : 0);
+
+	utils::UnstableMap<const Clock*, size_t> clockIdx;
+	writer.number(m_clocks.size());
+	for (const auto &clock : m_clocks) {
+		size_t idx = clockIdx.size()+1;
+		clockIdx[clock.get()] = idx;
+
+		if (auto *derived = dynamic_cast<const DerivedClock*>(clock.get())) {
+			writer.number(clockIdx.find(derived->getParentClock())->second);
+			writer.rational(derived->getFrequencyMuliplier());
+		} else {
+			writer.number(0);
+			writer.rational(clock->absoluteFrequency());
+		}
+
+		writer.string(clock->getName());
+		writer.string(clock->getResetName());
+		writer.number((std::uint64_t) clock->getTriggerEvent());
+		writer.boolean(clock->getPhaseSynchronousWithParent());
+		writer.rational(clock->getMinResetTime());
+		writer.number(clock->getMinResetCycles());
+
+		const auto &regAttribs = clock->getRegAttribs();
+		writer.attributes(regAttribs);
+		writer.number((std::uint64_t) regAttribs.resetType);
+		writer.number((std::uint64_t) regAttribs.memoryResetType);
+		writer.boolean(regAttribs.initializeRegs);
+		writer.boolean(regAttribs.initializeMemory);
+		writer.boolean(regAttribs.synchronizationRegister);
+		writer.number((std::uint64_t) regAttribs.resetActive);
+		writer.number((std::uint64_t) regAttribs.registerResetPinUsage);
+		writer.number((std::uint64_t) regAttribs.registerEnablePinUsage);
+	}
+
+	// Groups in pre-order such that parents always precede their children.
+	utils::UnstableMap<const NodeGroup*, size_t> groupIdx;
+	std::vector<const NodeGroup*> groups = { m_root.get() };
+	for (size_t i = 0; i < groups.size(); i++) {
+		groupIdx[groups[i]] = i;
+		for (const auto &child : groups[i]->getChildren())
+			groups.push_back(child.get());
+	}
+
+	auto writeGroup = [&](const NodeGroup *group) {
+		writer.number((std::uint64_t) group->getGroupType());
+		writer.string(group->getName());
+		writer.string(group->getInstanceName());
+		writer.string(group->getComment());
+	};
+	writeGroup(m_root.get());
+	writer.number(groups.size()-1);
+	for (auto i : utils::Range<size_t>(1, groups.size())) {
+		writer.number(groupIdx.find(groups[i]->getParent())->second);
+		writeGroup(groups[i]);
+	}
+
+	std::vector<const BaseNode*> nodes;
+	nodes.reserve(m_nodes.size());
+	for (const auto &node : m_nodes)
+		nodes.push_back(node.get());
+	std::sort(nodes.begin(), nodes.end(), [](const BaseNode *lhs, const BaseNode *rhs) { return lhs->getId() < rhs->getId(); });
+
+	utils::UnstableMap<const BaseNode*, size_t> nodeIdx;
+	for (auto i : utils::Range(nodes.size()))
+		nodeIdx[nodes[i]] = i+1;
+
+	auto writeNodeRef = [&](const BaseNode *node) {
+		writer.number(node == nullptr ? 0 : nodeIdx.find(node)->second);
+	};
+
+	NodePayloadWriter payloadWriter(writer);
+	writer.number(nodes.size());
+	for (const auto *node : nodes) {
+		writer.number(groupIdx.find(node->getGroup())->second);
+		writer.number(node->getNumInputPorts());
+		writer.number(node->getNumOutputPorts());
+		for (auto i : utils::Range(node->getNumOutputPorts())) {
+			writer.connectionType(node->getOutputConnectionType(i));
+			writer.number(node->getOutputType(i));
+		}
+		writer.number(node->getClocks().size());
+		for (auto *clock : node->getClocks())
+			writer.number(clock == nullptr ? 0 : clockIdx.find(clock)->second);
+
+		node->visit(payloadWriter);
+	}
+
+	for (const auto *node : nodes)
+		for (auto i : utils::Range(node->getNumInputPorts())) {
+			auto driver = node->getDriver(i);
+			writeNodeRef(driver.node);
+			if (driver.node != nullptr)
+				writer.number(driver.port);
+		}
+
+	for (const auto &clock : m_clocks) {
+		writeNodeRef(clock->getLogicClockDriver());
+		writeNodeRef(clock->getLogicResetDriver());
+	}
+
+	if (options.names)
+		for (const auto *node : nodes) {
+			writer.string(node->getName());
+			writer.boolean(node->nameWasInferred());
+			writer.string(node->getComment());
+		}
+}
+
+void Circuit::saveSnapshot(const std::filesystem::path &filename, const CircuitSnapshotOptions &options) const
+{
+	std::ofstream stream(filename, std::ios::binary);
+	HCL_DESIGNCHECK_HINT(stream.is_open(), "Could not open " + filename.string() + " for writing the circuit snapshot!");
+	saveSnapshot(stream, options);
+}
+
+void Circuit::loadSnapshot(std::istream &stream)
+{
+	HCL_DESIGNCHECK_HINT(m_nodes.empty() && m_clocks.empty() && m_root->getChildren().empty(), "Circuit snapshots can only be loaded into empty circuits!");
+
+	SnapshotReader reader(stream);
+
+	char magic[sizeof(SNAPSHOT_MAGIC)] = {};
+	stream.read(magic, sizeof(magic));
+	HCL_DESIGNCHECK_HINT(stream.good() && std::equal(magic, magic + sizeof(magic), SNAPSHOT_MAGIC), "The file is not a circuit snapshot!");
+	auto version = reader.number();
+	HCL_DESIGNCHECK_HINT(version == SNAPSHOT_VERSION, "The circuit snapshot was written in format version " + std::to_string(version) + " but only version " + std::to_string(SNAPSHOT_VERSION) + " is supported!");
+	auto sections = reader.number();
+
+	std::vector<Clock*> clocks;
+	clocks.reserve(reader.number());
+	for ([[maybe_unused]] auto i : utils::Range(clocks.capacity())) {
+		Clock *clock;
+		if (Clock *parent = reader.reference(clocks)) {
+			auto *derived = createClock<DerivedClock>(parent);
+			derived->setFrequencyMuliplier(reader.rational());
+			clock = derived;
+		} else
+			clock = createClock<RootClock>("clk", reader.rational());
+
+		clock->setName(reader.string());
+		clock->setResetName(reader.string());
+		clock->setTriggerEvent(reader.enumeration(Clock::TriggerEvent(size_t(Clock::TriggerEvent::RISING_AND_FALLING) + 1)));
+		clock->setPhaseSynchronousWithParent(reader.boolean());
+		clock->setMinResetTime(reader.rational());
+		clock->setMinResetCycles(reader.number());
+
+		auto &regAttribs = clock->getRegAttribs();
+		regAttribs.userDefinedVendorAttributes.clear();
+		reader.attributes(regAttribs);
+		regAttribs.resetType = reader.enumeration(RegisterAttributes::ResetType(size_t(RegisterAttributes::ResetType::NONE) + 1));
+		regAttribs.memoryResetType = reader.enumeration(RegisterAttributes::ResetType(size_t(RegisterAttributes::ResetType::NONE) + 1));
+		regAttribs.initializeRegs = reader.boolean();
+		regAttribs.initializeMemory = reader.boolean();
+		regAttribs.synchronizationRegister = reader.boolean();
+		regAttribs.resetActive = reader.enumeration(RegisterAttributes::Active(size_t(RegisterAttributes::Active::HIGH) + 1));
+		regAttribs.registerResetPinUsage = reader.enumeration(RegisterAttributes::UsageType(size_t(RegisterAttributes::UsageType::DONT_USE) + 1));
+		regAttribs.registerEnablePinUsage = reader.enumeration(RegisterAttributes::UsageType(size_t(RegisterAttributes::UsageType::DONT_USE) + 1));
+
+		clocks.push_back(clock);
+	}
+
+	auto readGroup = [&](NodeGroup *group) {
+		group->setGroupType(reader.enumeration(NodeGroup::GroupType(size_t(NodeGroup::GroupType::SFU) + 1)));
+		group->setName(reader.string());
+		group->setInstanceName(reader.string());
+		group->setComment(reader.string());
+	};
+	std::vector<NodeGroup*> groups = { m_root.get() };
+	readGroup(m_root.get());
+	groups.reserve(reader.number() + 1);
+	while (groups.size() < groups.capacity()) {
+		auto parentIdx = reader.number();
+		HCL_DESIGNCHECK_HINT(parentIdx < groups.size(), "The circuit snapshot is corrupted!");
+		auto *group = groups[parentIdx]->addChildNodeGroup(NodeGroup::GroupType::ENTITY);
+		readGroup(group);
+		groups.push_back(group);
+	}
+
+	std::vector<BaseNode*> nodes;
+	nodes.reserve(reader.number());
+	std::vector<Node_RegSpawner*> resolvedSpawners;
+	std::vector<ConnectionType> outputTypes;
+	std::vector<NodeIO::OutputType> outputLatching;
+	std::vector<Clock*> nodeClocks;
+	for ([[maybe_unused]] auto n : utils::Range(nodes.capacity())) {
+		auto groupIdx = reader.number();
+		HCL_DESIGNCHECK_HINT(groupIdx < groups.size(), "The circuit snapshot is corrupted!");
+		size_t numInputs = reader.number();
+		outputTypes.resize(reader.number());
+		outputLatching.resize(outputTypes.size());
+		for (auto i : utils::Range(outputTypes.size())) {
+			outputTypes[i] = reader.connectionType();
+			outputLatching[i] = reader.enumeration(NodeIO::OutputType(NodeIO::OUTPUT_CONSTANT + 1));
+		}
+		nodeClocks.resize(reader.number());
+		for (auto &clock : nodeClocks)
+			clock = reader.reference(clocks);
+
+		auto *node = createNodeFromPayload(*this, groups[groupIdx], reader, reader.enumeration(NodeTag::COUNT), numInputs, outputTypes, resolvedSpawners);
+
+		NodeIO &io = *node;
+		if (io.getNumInputPorts() != numInputs)
+			io.resizeInputs(numInputs);
+		if (io.getNumOutputPorts() != outputTypes.size())
+			io.resizeOutputs(outputTypes.size());
+		for (auto i : utils::Range(outputTypes.size())) {
+			io.setOutputConnectionType(i, outputTypes[i]);
+			io.setOutputType(i, outputLatching[i]);
+		}
+
+		HCL_DESIGNCHECK_HINT(node->getClocks().size() == nodeClocks.size(), "The circuit snapshot is corrupted!");
+		for (auto i : utils::Range(nodeClocks.size()))
+			if (nodeClocks[i] != nullptr)
+				node->attachClock(nodeClocks[i], i);
+
+		nodes.push_back(node);
+	}
+
+	for (auto *node : nodes)
+		for (auto i : utils::Range(node->getNumInputPorts())) {
+			NodePort driver;
+			driver.node = reader.reference(nodes);
+			if (driver.node == nullptr) continue;
+			driver.port = reader.number();
+			HCL_DESIGNCHECK_HINT(driver.port < driver.node->getNumOutputPorts(), "The circuit snapshot is corrupted!");
+
+			// Output pins derive their connection type from what they are connected to.
+			auto *pin = dynamic_cast<Node_Pin*>(node);
+			if (pin != nullptr && i == 0 && pin->isOutputPin())
+				pin->connect(driver);
+			else
+				static_cast<NodeIO*>(node)->connectInput(i, driver);
+		}
+
+	for (auto *clock : clocks) {
+		if (auto *driver = reader.reference(nodes)) {
+			auto *signal2clk = dynamic_cast<Node_Signal2Clk*>(driver);
+			HCL_DESIGNCHECK_HINT(signal2clk != nullptr, "The circuit snapshot is corrupted!");
+			clock->setLogicClockDriver(signal2clk);
+		}
+		if (auto *driver = reader.reference(nodes)) {
+			auto *signal2rst = dynamic_cast<Node_Signal2Rst*>(driver);
+			HCL_DESIGNCHECK_HINT(signal2rst != nullptr, "The circuit snapshot is corrupted!");
+			clock->setLogicResetDriver(signal2rst);
+		}
+	}
+
+	// Resolving bypasses the outputs and thus has to wait until the spawners are connected.
+	for (auto *spawner : resolvedSpawners)
+		spawner->markResolved();
+
+	if (sections & SECTION_NAMES)
+		for (auto *node : nodes) {
+			auto name = reader.string();
+			if (reader.boolean())
+				node->setInferredName(std::move(name));
+			else
+				node->setName(std::move(name));
+			node->setComment(reader.string());
+		}
+}
+
+void Circuit::loadSnapshot(const std::filesystem::path &filename)
+{
+	std::ifstream stream(filename, std::ios::binary);
+	HCL_DESIGNCHECK_HINT(stream.is_open(), "Could not open the circuit snapshot " + filename.string() + "!");
+	loadSnapshot(stream);
+}
+
+}
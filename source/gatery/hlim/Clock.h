@@ -123,6 +123,10 @@ class Clock
 		/// @brief Binds a logic signal (through a Node_Signal2Clk) to this clock to drive the reset.
 		/// @details If nothing is bound, or if the bound Node_Signal2Rst is not driven (evaluated independently for simulation and export), the reset is driven by the simulator / routed to the top module on export.
 		void setLogicResetDriver(Node_Signal2Rst *driver);
+		/// Returns the Node_Signal2Clk bound through setLogicClockDriver, if any.
+		inline Node_Signal2Clk *getLogicClockDriver() const { return m_clockDriver; }
+		/// Returns the Node_Signal2Rst bound through setLogicResetDriver, if any.
+		inline Node_Signal2Rst *getLogicResetDriver() const { return m_resetDriver; }
 		/// Returns a unique ID for this clock that can be used as a stable key in containers. 
 		size_t getId() const { HCL_ASSERT(m_id != ~0ull); return m_id; }
 		void setId(std::uint64_t id, utils::RestrictTo<Circuit>) { m_id = id; }
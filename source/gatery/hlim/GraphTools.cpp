@@ -31,6 +31,7 @@
 
 #include "NodePort.h"
 #include "Node.h"
+#include "NodeGroup.h"
 #include "../simulation/ReferenceSimulator.h"
 
 #include <set>
@@ -312,4 +313,78 @@ hlim::NodePort findDriver(hlim::BaseNode *node, const FindDriverOpts &opts)
 	return driver;
 }
 
+namespace {
+	std::uint64_t hashCombine(std::uint64_t seed, std::uint64_t value)
+	{
+		return seed ^ (value + 0x9e3779b97f4a7c15ull + (seed << 6) + (seed >> 2));
+	}
+}
+
+std::uint64_t hashNodeGroupStructure(const NodeGroup *group)
+{
+	// Number of refinement rounds, each round lets a label see one more hop of its surroundings.
+	const size_t NUM_ROUNDS = 3;
+
+	std::vector<const BaseNode*> nodes;
+	std::vector<std::uint64_t> labels;
+
+	std::uint64_t groupHash = 0;
+	std::vector<std::pair<const NodeGroup*, size_t>> openList = { {group, 0} };
+	while (!openList.empty()) {
+		auto [g, depth] = openList.back();
+		openList.pop_back();
+
+		std::uint64_t groupLabel = hashCombine(hashCombine((std::uint64_t) g->getGroupType(), depth), g->getChildren().size());
+		groupHash += groupLabel;
+
+		for (auto *node : g->getNodes()) {
+			std::uint64_t label = hashCombine(groupLabel, std::hash<std::string>{}(node->getTypeName()));
+			label = hashCombine(label, node->getNumInputPorts());
+			label = hashCombine(label, node->getClocks().size());
+			for (auto i : utils::Range(node->getNumOutputPorts())) {
+				const auto &type = node->getOutputConnectionType(i);
+				label = hashCombine(label, type.type);
+				label = hashCombine(label, type.width);
+				label = hashCombine(label, node->getOutputType(i));
+			}
+			nodes.push_back(node);
+			labels.push_back(label);
+		}
+
+		for (const auto &child : g->getChildren())
+			openList.push_back({child.get(), depth+1});
+	}
+
+	utils::UnstableMap<const BaseNode*, size_t> nodeIdx;
+	for (auto i : utils::Range(nodes.size()))
+		nodeIdx[nodes[i]] = i;
+
+	std::vector<std::uint64_t> refined(labels.size());
+	for ([[maybe_unused]] auto round : utils::Range(NUM_ROUNDS)) {
+		for (auto i : utils::Range(nodes.size())) {
+			std::uint64_t label = labels[i];
+			for (auto input : utils::Range(nodes[i]->getNumInputPorts())) {
+				auto driver = nodes[i]->getDriver(input);
+				if (driver.node == nullptr)
+					label = hashCombine(label, 1);
+				else {
+					auto it = nodeIdx.find(driver.node);
+					if (it == nodeIdx.end())
+						label = hashCombine(label, 2);
+					else
+						label = hashCombine(hashCombine(label, labels[it->second]), driver.port);
+				}
+			}
+			refined[i] = label;
+		}
+		std::swap(labels, refined);
+	}
+
+	std::sort(labels.begin(), labels.end());
+	std::uint64_t hash = groupHash;
+	for (auto label : labels)
+		hash = hashCombine(hash, label);
+	return hash;
+}
+
 }
@@ -88,5 +88,14 @@ namespace gtry::hlim {
 	};
 	hlim::NodePort findDriver(hlim::BaseNode *node, const FindDriverOpts &opts = {});
 
+	/**
+	 * @brief Hashes the structure of a node group including all its child groups.
+	 * @details The hash covers node types, port layouts, output types, the group hierarchy, and how nodes are connected among each other,
+	 * but not names, ids, or memory addresses. Nodes are identified by iteratively refined labels of their surroundings, so the result
+	 * does not depend on the order in which nodes were created. All drivers outside of the group are considered alike.
+	 * Equal hashes are necessary but not sufficient for two groups to be interchangeable.
+	 */
+	std::uint64_t hashNodeGroupStructure(const NodeGroup *group);
+
 
 }
@@ -42,6 +42,8 @@ BaseNode::BaseNode(size_t numInputs, size_t numOutputs)
 BaseNode::~BaseNode()
 {
 	HCL_ASSERT_NOTHROW(m_refCounter == 0);
+	if (getObserver() != nullptr)
+		getObserver()->onNodeDestroyed(this);
 	moveToGroup(nullptr);
 	for (auto i : utils::Range(m_clocks.size()))
 		detachClock(i);
@@ -241,12 +243,17 @@ std::string BaseNode::attemptInferOutputName(size_t outputPort) const
 
 void BaseNode::estimateSignalDelay(SignalDelay &sigDelay)
 {
-	HCL_ASSERT_HINT(getNumOutputPorts() == 0, "estimateSignalDelay not implemented for node type " + getTypeName());
+	// Nodes without a timing model are treated as start points of timing paths.
+	for (auto i : utils::Range(getNumOutputPorts()))
+		if (sigDelay.contains({.node = this, .port = i}))
+			for (auto &f : sigDelay.getDelay({.node = this, .port = i}))
+				f = 0.0f;
 }
 
 void BaseNode::estimateSignalDelayCriticalInput(SignalDelay &sigDelay, size_t outputPort, size_t outputBit, size_t& inputPort, size_t& inputBit)
 {
-	HCL_ASSERT_HINT(false, "estimateSignalDelayCriticalInput not implemented for node type " + getTypeName());
+	inputPort = ~0u;
+	inputBit = ~0u;
 }
 
 void BaseNode::forwardSignalDelay(SignalDelay &sigDelay, unsigned input, unsigned output)
@@ -122,6 +122,7 @@ namespace gtry::hlim {
 		void dropMetaInfo() { m_metaInfo.reset(); }
 
 		NodeGroupMetaInfo* getMetaInfo() { return m_metaInfo.get(); }
+		const NodeGroupMetaInfo* getMetaInfo() const { return m_metaInfo.get(); }
 
 		static void configTree(utils::ConfigTree config);
 
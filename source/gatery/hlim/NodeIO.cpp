@@ -64,7 +64,7 @@ NodePort NodeIO::getNonSignalDriver(size_t inputPort) const
 	return np;
 }
 
-const std::vector<NodePort> &NodeIO::getDirectlyDriven(size_t outputPort) const
+const NodeIO::ConsumerList &NodeIO::getDirectlyDriven(size_t outputPort) const
 {
 	return m_outputPorts[outputPort].connections;
 }
@@ -106,6 +106,9 @@ void NodeIO::connectInput(size_t inputPort, const NodePort &output)
 		auto &outPort = inPort.node->m_outputPorts[inPort.port];
 		outPort.connections.push_back({.node = static_cast<BaseNode*>(this), .port = inputPort});
 	}
+
+	if (m_observer != nullptr)
+		m_observer->onInputRewired(static_cast<BaseNode*>(this));
 }
 
 void NodeIO::disconnectInput(size_t inputPort)
@@ -126,6 +129,9 @@ void NodeIO::disconnectInput(size_t inputPort)
 		
 		inPort.node = nullptr;
 		inPort.port = INV_PORT;
+
+		if (m_observer != nullptr)
+			m_observer->onInputRewired(static_cast<BaseNode*>(this));
 	}
 }
 
@@ -21,6 +21,8 @@
 #include "ConnectionType.h"
 #include "GraphExploration.h"
 
+#include <boost/container/small_vector.hpp>
+
 #include <vector>
 
 namespace gtry::hlim {
@@ -29,6 +31,21 @@ class BaseNode;
 class NodeIO;
 class Circuit;
 
+/**
+ * @brief Interface to get notified about connectivity changes of individual nodes.
+ * @details Used to invalidate information that is derived from and cached alongside the graph.
+ */
+class NodeIOObserver
+{
+	public:
+		virtual ~NodeIOObserver() = default;
+
+		/// Called after an input of the observed node got connected, rewired, or disconnected.
+		virtual void onInputRewired(BaseNode *node) = 0;
+		/// Called when the observed node is about to be destroyed.
+		virtual void onNodeDestroyed(BaseNode *node) = 0;
+};
+
 class NodeIO
 {
 	public:
@@ -39,6 +56,9 @@ class NodeIO
 			OUTPUT_CONSTANT
 		};
 
+		/// Consumers of an output port. Most outputs only drive one or two inputs, so these are stored inline.
+		using ConsumerList = boost::container::small_vector<NodePort, 2>;
+
 		virtual ~NodeIO();
 
 		inline size_t getNumInputPorts() const { return m_inputPorts.size(); }
@@ -48,7 +68,7 @@ class NodeIO
 		NodePort getDriver(size_t inputPort) const;
 		NodePort getNonSignalDriver(size_t inputPort) const;
 
-		const std::vector<NodePort> &getDirectlyDriven(size_t outputPort) const;
+		const ConsumerList &getDirectlyDriven(size_t outputPort) const;
 
 		ExplorationFwdDepthFirst exploreOutput(size_t port) { return ExplorationFwdDepthFirst({.node=(BaseNode*)this, .port = port}); }
 		ExplorationBwdDepthFirst exploreInput(size_t port) { return ExplorationBwdDepthFirst({.node=(BaseNode*)this, .port = port}); }
@@ -59,6 +79,10 @@ class NodeIO
 		virtual void bypassOutputToInput(size_t outputPort, size_t inputPort);
 
 		inline void rewireInput(size_t inputPort, const NodePort &output) { connectInput(inputPort, output); }
+
+		/// Sets an observer that is notified whenever the inputs of this node are rewired (only one observer per node).
+		inline void setObserver(NodeIOObserver *observer) { m_observer = observer; }
+		inline NodeIOObserver *getObserver() const { return m_observer; }
 	protected:
 		void setOutputConnectionType(size_t outputPort, const ConnectionType &connectionType);
 		void setOutputType(size_t outputPort, OutputType outputType);
@@ -72,11 +96,12 @@ class NodeIO
 		struct OutputPort {
 			ConnectionType connectionType;
 			OutputType outputType = OUTPUT_IMMEDIATE;
-			std::vector<NodePort> connections;
+			ConsumerList connections;
 		};
 
-		std::vector<NodePort> m_inputPorts;
-		std::vector<OutputPort> m_outputPorts;
+		boost::container::small_vector<NodePort, 3> m_inputPorts;
+		boost::container::small_vector<OutputPort, 1> m_outputPorts;
+		NodeIOObserver *m_observer = nullptr;
 
 		friend class Circuit;
 };
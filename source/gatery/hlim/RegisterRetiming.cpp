@@ -616,6 +616,7 @@ bool retimeForwardToOutput(Circuit &circuit, Subnet &area, NodePort output, cons
 	}
 
 	Subnet newNodes;
+	Subnet rewiredNodes;
 
 	auto registersToCheckForBypass = retimingPlan->registersToBeRemoved;
 
@@ -689,14 +690,17 @@ bool retimeForwardToOutput(Circuit &circuit, Subnet &area, NodePort output, cons
 				if (!retimingPlan->areaToBeRetimed.contains(inputNP.node))
 					inputsToRewire.push_back(inputNP);
 
-		for (auto inputNP : inputsToRewire)
+		for (auto inputNP : inputsToRewire) {
 			inputNP.node->rewireInput(inputNP.port, {.node = reg, .port = 0ull});
+			rewiredNodes.add(inputNP.node);
+		}
 	}
 	
 
 	// Replace enables of anchored registers and memory write ports
 	for (const auto &repl : retimingPlan->enableReplacements) {
 		repl.input.node->rewireInput(repl.input.port, repl.newEnable);
+		rewiredNodes.add(repl.input.node);
 		for (auto &n : repl.newNodes)
 			newNodes.add(n);
 	}
@@ -750,8 +754,10 @@ bool retimeForwardToOutput(Circuit &circuit, Subnet &area, NodePort output, cons
 	}
 
 	// After everything has been prepared, actually apply the bypasses.
-	for (const auto &driven_newDriver : bypasses)
+	for (const auto &driven_newDriver : bypasses) {
 		driven_newDriver.first.node->rewireInput(driven_newDriver.first.port, driven_newDriver.second);
+		rewiredNodes.add(driven_newDriver.first.node);
+	}
 	
 	
 
@@ -761,6 +767,9 @@ bool retimeForwardToOutput(Circuit &circuit, Subnet &area, NodePort output, cons
 	if (settings.newNodes) 
 		*settings.newNodes = std::move(newNodes);
 
+	if (settings.rewiredNodes) 
+		*settings.rewiredNodes = std::move(rewiredNodes);
+
 	return true;
 }
 
@@ -768,29 +777,23 @@ bool retimeForwardToOutput(Circuit &circuit, Subnet &area, NodePort output, cons
 
 void retimeForward(Circuit &circuit, Subnet &subnet)
 {
+	// estimate signal delays once, afterwards only the parts affected by the retiming are updated
+	hlim::SignalDelay delays;
+	delays.compute(subnet);
+
 	bool done = false;
 	while (!done) {
 
-		// estimate signal delays
-		hlim::SignalDelay delays;
-		delays.compute(subnet);
-
 		// Find critical output
+		auto critical = delays.getCriticalOutput();
 		hlim::NodePort criticalOutput;
 		size_t criticalBit = ~0u;
 		float criticalTime = 0.0f;
-		for (auto &n : subnet)
-			for (auto i : utils::Range(n->getNumOutputPorts())) {
-				hlim::NodePort np = {.node = n, .port = i};
-				auto d = delays.getDelay(np);
-				for (auto i : utils::Range(d.size())) {   
-					if (d[i] > criticalTime) {
-						criticalTime = d[i];
-						criticalOutput = np;
-						criticalBit = i;
-					}
-				}
-			}
+		if (critical) {
+			criticalOutput = critical->output;
+			criticalBit = critical->bit;
+			criticalTime = critical->delay;
+		}
 /*
 		{
 			DotExport exp("signalDelays.dot");
@@ -857,7 +860,14 @@ void retimeForward(Circuit &circuit, Subnet &subnet)
 		}
 
 		if (retimingTarget.node != nullptr && dynamic_cast<Node_Register*>(retimingTarget.node) == nullptr) {
-			done = !retimeForwardToOutput(circuit, subnet, retimingTarget, {.failureIsError=false});
+			Subnet changedNodes;
+			Subnet rewiredNodes;
+			done = !retimeForwardToOutput(circuit, subnet, retimingTarget, {.failureIsError=false, .newNodes=&changedNodes, .rewiredNodes=&rewiredNodes});
+			if (!done) {
+				for (auto n : rewiredNodes)
+					changedNodes.add(n);
+				delays.update(subnet, changedNodes);
+			}
 		} else
 			done = true;
 	
@@ -1547,7 +1557,7 @@ bool retimeBackwardtoOutput(Circuit &circuit, Subnet &area, const utils::StableS
 				mux->moveToGroup(reg->getGroup());
 				mux->setComment("A register with a reset value was retimed backwards from here. To preserve the reset value, this multiplexer overrides the signal during reset and in the first cycle after with the original reset value.");
 
-				std::vector<NodePort> driven = reg->getDirectlyDriven(0);
+				NodeIO::ConsumerList driven = reg->getDirectlyDriven(0);
 				for (auto inputNP : driven)
 					if (inputNP.node != mux)
 						inputNP.node->rewireInput(inputNP.port, {.node = mux, .port = 0ull});
@@ -1843,7 +1853,7 @@ void ReadModifyWriteHazardLogicBuilder::build(bool useMemory)
 		// Finally, mux back to override what the read port appears to read
 
 		// Fetch a list of all consumers (before we build consumers of our own) for later to rewire
-		std::vector<NodePort> consumers = rdPort.dataOutOutputDriver.node->getDirectlyDriven(rdPort.dataOutOutputDriver.port);
+		NodeIO::ConsumerList consumers = rdPort.dataOutOutputDriver.node->getDirectlyDriven(rdPort.dataOutOutputDriver.port);
 
 		// Split What we read into words
 		auto rpOutput = splitWords(rdPort.dataOutOutputDriver, dataWords);
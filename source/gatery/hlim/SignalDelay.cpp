@@ -27,51 +27,135 @@
 
 namespace gtry::hlim {
 
+bool SignalDelay::CriticalOutputOrder::operator()(const std::pair<float, NodePort> &lhs, const std::pair<float, NodePort> &rhs) const
+{
+	if (lhs.first != rhs.first)
+		return lhs.first > rhs.first;
+	// Break ties by node id to be independent of memory addresses
+	if (lhs.second.node->getId() != rhs.second.node->getId())
+		return lhs.second.node->getId() < rhs.second.node->getId();
+	return lhs.second.port < rhs.second.port;
+}
+
 void SignalDelay::compute(const Subnet &subnet)
 {
 	allocate(subnet);
-	zero();
 
 	TopologicalSort sorter;
 	const auto &sorted = sorter.sort(subnet);
 
 	for (auto n : sorted)
-		n->estimateSignalDelay(*this);
+		estimate(n);
+}
+
+void SignalDelay::update(const Subnet &subnet, const Subnet &changedNodes)
+{
+	// Gather the fan-out cone of the changed nodes. Latched outputs (e.g. of registers) do not depend
+	// on the delays of the inputs, so the cone only continues past them if the node itself changed.
+	Subnet cone;
+	std::vector<BaseNode*> openList;
+	for (auto n : changedNodes)
+		if (subnet.contains(n)) {
+			cone.add(n);
+			openList.push_back(n);
+		}
+
+	while (!openList.empty()) {
+		auto *node = openList.back();
+		openList.pop_back();
+
+		bool changed = changedNodes.contains(node);
+		for (auto i : utils::Range(node->getNumOutputPorts())) {
+			if (!changed && node->getOutputType(i) == NodeIO::OUTPUT_LATCHED) continue;
+			for (auto np : node->getDirectlyDriven(i))
+				if (subnet.contains(np.node) && !cone.contains(np.node)) {
+					cone.add(np.node);
+					openList.push_back(np.node);
+				}
+		}
+	}
+
+	for (auto n : cone)
+		for (auto i : utils::Range(n->getNumOutputPorts())) {
+			NodePort np{.node=n, .port=i};
+			if (!outputIsDependency(np) && !m_outputToBitDelays.contains(np))
+				allocate(np);
+		}
+
+	// Everything driving the cone from the outside is up to date and thus considered ready by the sort.
+	TopologicalSort sorter;
+	const auto &sorted = sorter.sort(cone);
+
+	for (auto n : sorted)
+		estimate(n);
+}
+
+std::optional<SignalDelay::CriticalOutput> SignalDelay::getCriticalOutput() const
+{
+	if (m_criticalOutputs.empty()) return {};
+
+	const auto &[maxDelay, np] = *m_criticalOutputs.begin();
+	if (maxDelay <= 0.0f) return {};
+
+	auto delays = getDelay(np);
+	for (auto i : utils::Range(delays.size()))
+		if (delays[i] == maxDelay)
+			return CriticalOutput{.output = np, .bit = i, .delay = maxDelay};
+
+	HCL_ASSERT_HINT(false, "Critical output bookkeeping is out of sync with the stored delays!");
+	return {};
+}
+
+void SignalDelay::estimate(BaseNode *node)
+{
+	node->estimateSignalDelay(*this);
+
+	for (auto i : utils::Range(node->getNumOutputPorts())) {
+		auto it = m_outputToBitDelays.find({.node=node, .port=i});
+		if (it == m_outputToBitDelays.end()) continue;
+
+		auto &alloc = it->second;
+		float maxDelay = 0.0f;
+		for (auto f : std::span<const float>(m_delays.data() + alloc.offset, alloc.width))
+			maxDelay = std::max(maxDelay, f);
+
+		if (maxDelay != alloc.maxDelay) {
+			m_criticalOutputs.erase(std::make_pair(alloc.maxDelay, it->first));
+			alloc.maxDelay = maxDelay;
+			m_criticalOutputs.insert(std::make_pair(alloc.maxDelay, it->first));
+		}
+	}
 }
 
 void SignalDelay::allocate(const Subnet &subnet)
 {
 	m_outputToBitDelays.clear();
+	m_criticalOutputs.clear();
+	m_delays.clear();
 
-	utils::StableMap<NodePort, std::pair<size_t, size_t>> allocations;
-
-	size_t totalSize = 0;
 	for (auto n : subnet.getNodes())
 		for (auto i : utils::Range(n->getNumOutputPorts())) {
 			NodePort np{.node=n, .port=i};
 
 			if (outputIsDependency(np)) continue;
 
-			size_t width = getOutputWidth(np);
-			allocations[np] = {totalSize, width};
-			totalSize += width;
+			allocate(np);
 		}
-
-	m_delays.resize(totalSize);
-	for (auto &alloc : allocations)
-		m_outputToBitDelays[alloc.first] = std::span<float>(m_delays.data() + alloc.second.first, alloc.second.second);
 }
 
-void SignalDelay::zero()
+void SignalDelay::allocate(const NodePort &np)
 {
-	memset(m_delays.data(), 0, m_delays.size() * sizeof(float));
+	size_t width = getOutputWidth(np);
+	m_outputToBitDelays[np] = {.offset = m_delays.size(), .width = width, .maxDelay = 0.0f};
+	m_criticalOutputs.insert(std::make_pair(0.0f, np));
+	m_delays.resize(m_delays.size() + width, 0.0f);
 }
 
 std::span<float> SignalDelay::getDelay(const NodePort &np)
 {
 	auto it = m_outputToBitDelays.find(np);
 	if (it != m_outputToBitDelays.end())
-		return it->second; 
+		return std::span<float>(m_delays.data() + it->second.offset, it->second.width);
 
 	size_t width = 0;
 	if (np.node != nullptr)
@@ -85,7 +169,7 @@ std::span<const float> SignalDelay::getDelay(const NodePort &np) const
 {
 	auto it = m_outputToBitDelays.find(np);
 	if (it != m_outputToBitDelays.end())
-		return it->second; 
+		return std::span<const float>(m_delays.data() + it->second.offset, it->second.width);
 
 	size_t width = 0;
 	if (np.node != nullptr)
@@ -20,33 +20,78 @@
 #include <gatery/utils/StableContainers.h>
 
 #include <map>
+#include <optional>
+#include <set>
 #include <span>
 #include <vector>
 
 #include "../utils/Exceptions.h"
 #include "../utils/Preprocessor.h"
 
+#include "NodePort.h"
+#include "TimingModel.h"
+
 namespace gtry::hlim {
 
-struct NodePort;
+class BaseNode;
 class Circuit;
 class Subnet;
 
+/**
+ * @brief Rough estimate of the combinatorial signal delays of all outputs in a subnet.
+ * @details After a full compute(), localized modifications of the graph can be incorporated with update(), which only
+ * re-estimates the combinatorial fan-out cone of the modified nodes. The output with the highest delay is tracked
+ * in an ordered set and can be queried in logarithmic time.
+ */
 class SignalDelay {
 	public:
+		struct CriticalOutput {
+			NodePort output;
+			size_t bit;
+			float delay;
+		};
+
+		SignalDelay() = default;
+		SignalDelay(const TimingModel &timingModel) : m_timingModel(timingModel) { }
+
+		inline const TimingModel &getTimingModel() const { return m_timingModel; }
+
 		void compute(const Subnet &subnet);
+		/**
+		 * @brief Re-estimates the delays of the given nodes and of all nodes in the subnet that they drive combinatorically.
+		 * @param subnet The subnet for which the delays were computed. Newly created nodes must already be part of it.
+		 * @param changedNodes All nodes that were newly created or whose inputs were rewired.
+		 */
+		void update(const Subnet &subnet, const Subnet &changedNodes);
+
+		/// Returns the output (and bit) with the highest delay or nothing if all delays are zero.
+		std::optional<CriticalOutput> getCriticalOutput() const;
 
 		inline bool contains(const NodePort &np) const { return m_outputToBitDelays.contains(np); }
 		std::span<float> getDelay(const NodePort &np);
 		std::span<const float> getDelay(const NodePort &np) const;
 	protected:
+		struct Allocation {
+			size_t offset;
+			size_t width;
+			/// Delay of the slowest bit, as currently stored in m_criticalOutputs.
+			float maxDelay;
+		};
+
+		struct CriticalOutputOrder {
+			bool operator()(const std::pair<float, NodePort> &lhs, const std::pair<float, NodePort> &rhs) const;
+		};
+
+		TimingModel m_timingModel;
 		mutable std::vector<float> m_zeros;
 		std::vector<float> m_delays;
-		utils::UnstableMap<NodePort, std::span<float>> m_outputToBitDelays;
-
+		utils::UnstableMap<NodePort, Allocation> m_outputToBitDelays;
+		/// All outputs ordered by descending maximum delay.
+		std::set<std::pair<float, NodePort>, CriticalOutputOrder> m_criticalOutputs;
 
 		void allocate(const Subnet &subnet);
-		void zero();
+		void allocate(const NodePort &np);
+		void estimate(BaseNode *node);
 };
 
 }
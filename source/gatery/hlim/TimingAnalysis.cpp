@@ -0,0 +1,131 @@
+/*  This file is part of Gatery, a library for circuit design.
+	Copyright (C) 2021 Michael Offel, Andreas Ley
+
+	Gatery is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	Gatery is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#include "gatery/pch.h"
+
+#include "TimingAnalysis.h"
+#include "Subnet.h"
+#include "Node.h"
+#include "NodeGroup.h"
+#include "Clock.h"
+#include "coreNodes/Node_Pin.h"
+
+#include "../utils/Range.h"
+
+#include <algorithm>
+#include <iomanip>
+
+namespace gtry::hlim {
+
+void TimingAnalysis::analyze(const Subnet &subnet, size_t numPathsPerClock)
+{
+	m_criticalPaths.clear();
+	m_signalDelay.compute(subnet);
+
+	// Endpoints are all inputs of clocked nodes and output pins.
+	utils::StableMap<Clock*, std::vector<TimingPath>> endpoints;
+	for (auto n : subnet) {
+		Clock *clock = nullptr;
+		for (auto c : n->getClocks())
+			if (c != nullptr) {
+				clock = c;
+				break;
+			}
+
+		if (clock == nullptr && dynamic_cast<Node_Pin*>(n) == nullptr) continue;
+
+		for (auto i : utils::Range(n->getNumInputPorts())) {
+			auto driver = n->getDriver(i);
+			if (driver.node == nullptr || !m_signalDelay.contains(driver)) continue;
+
+			auto delays = m_signalDelay.getDelay(driver);
+			if (delays.empty()) continue;
+			auto maxIt = std::max_element(delays.begin(), delays.end());
+
+			endpoints[clock].push_back({
+				.clock = clock,
+				.endpoint = {.node = n, .port = i},
+				.delay = *maxIt,
+			});
+			// Remember the critical bit in the (not yet traced) path
+			endpoints[clock].back().elements.push_back({.output = driver, .bit = (size_t)(maxIt - delays.begin()), .arrival = *maxIt});
+		}
+	}
+
+	for (auto &[clock, paths] : endpoints) {
+		size_t numPaths = std::min(numPathsPerClock, paths.size());
+		std::partial_sort(paths.begin(), paths.begin() + numPaths, paths.end(), [](const TimingPath &lhs, const TimingPath &rhs) {
+			if (lhs.delay != rhs.delay)
+				return lhs.delay > rhs.delay;
+			return utils::StableCompare<NodePort>{}(lhs.endpoint, rhs.endpoint);
+		});
+		paths.resize(numPaths);
+
+		for (auto &path : paths) {
+			auto last = path.elements.back();
+			path.elements.clear();
+			traceCriticalPath(path, last.output, last.bit, subnet.getNodes().size());
+		}
+
+		m_criticalPaths[clock] = std::move(paths);
+	}
+}
+
+void TimingAnalysis::traceCriticalPath(TimingPath &path, NodePort driver, size_t bit, size_t maxLength)
+{
+	while (driver.node != nullptr && m_signalDelay.contains(driver) && path.elements.size() <= maxLength) {
+		path.elements.push_back({.output = driver, .bit = bit, .arrival = m_signalDelay.getDelay(driver)[bit]});
+
+		size_t inputPort, inputBit;
+		driver.node->estimateSignalDelayCriticalInput(m_signalDelay, driver.port, bit, inputPort, inputBit);
+		if (inputPort == ~0u) break;
+
+		driver = driver.node->getDriver(inputPort);
+		bit = inputBit;
+	}
+
+	std::reverse(path.elements.begin(), path.elements.end());
+}
+
+void TimingAnalysis::writeReport(std::ostream &stream) const
+{
+	auto describeNode = [](const BaseNode *node) {
+		std::stringstream desc;
+		desc << node->getTypeName() << " " << node->getId();
+		if (!node->getName().empty())
+			desc << " '" << node->getName() << "'";
+		if (node->getGroup() != nullptr)
+			desc << " in " << node->getGroup()->instancePath();
+		return desc.str();
+	};
+
+	for (const auto &[clock, paths] : m_criticalPaths) {
+		if (clock != nullptr)
+			stream << "Clock domain " << clock->getName() << " (period " << toNanoseconds(1 / clock->absoluteFrequency()) << " ns)" << std::endl;
+		else
+			stream << "Paths to output pins" << std::endl;
+
+		for (auto i : utils::Range(paths.size())) {
+			const auto &path = paths[i];
+			stream << "  #" << i+1 << " delay " << path.delay << " into input " << path.endpoint.port << " of " << describeNode(path.endpoint.node) << std::endl;
+			for (const auto &element : path.elements)
+				stream << "    " << std::setw(10) << element.arrival << "  output " << element.output.port << " bit " << element.bit << " of " << describeNode(element.output.node) << std::endl;
+		}
+	}
+}
+
+}
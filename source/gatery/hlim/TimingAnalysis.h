@@ -0,0 +1,86 @@
+/*  This file is part of Gatery, a library for circuit design.
+	Copyright (C) 2021 Michael Offel, Andreas Ley
+
+	Gatery is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	Gatery is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include "SignalDelay.h"
+#include "TimingModel.h"
+#include "NodePort.h"
+
+#include <gatery/utils/StableContainers.h>
+
+#include <ostream>
+#include <vector>
+
+namespace gtry::hlim {
+
+class Clock;
+class Subnet;
+
+/**
+ * @brief A combinatorial path ending in the input of a clocked node or of an output pin.
+ */
+struct TimingPath {
+	struct Element {
+		/// Output (and bit) through which the path passes.
+		NodePort output;
+		size_t bit;
+		/// Estimated arrival time at that output.
+		float arrival;
+	};
+
+	/// Clock of the node in which the path ends, nullptr for paths ending in output pins.
+	Clock *clock = nullptr;
+	/// Input port in which the path ends.
+	NodePort endpoint;
+	/// Total delay of the path.
+	float delay = 0.0f;
+	/// Elements of the path, from the start point to the output driving the endpoint.
+	std::vector<Element> elements;
+};
+
+/**
+ * @brief Static timing estimation that reports the most critical paths of each clock domain.
+ * @details Builds on the rough estimates of SignalDelay, so the reported delays are only as good as the TimingModel of the
+ * target technology. It is intended for quickly spotting timing regressions, not as a replacement for the timing analysis of
+ * the vendor tools.
+ */
+class TimingAnalysis {
+	public:
+		TimingAnalysis(const TimingModel &timingModel = {}) : m_signalDelay(timingModel) { }
+
+		/**
+		 * @brief Estimates all signal delays in the subnet and extracts the most critical paths.
+		 * @param subnet The nodes to analyze. Paths are cut where they leave the subnet.
+		 * @param numPathsPerClock How many of the most critical paths to extract for each clock domain.
+		 */
+		void analyze(const Subnet &subnet, size_t numPathsPerClock = 10);
+
+		/// The most critical paths of each clock domain (sorted by decreasing delay). Paths into output pins are listed under nullptr.
+		inline const utils::StableMap<Clock*, std::vector<TimingPath>> &getCriticalPaths() const { return m_criticalPaths; }
+		inline const SignalDelay &getSignalDelay() const { return m_signalDelay; }
+
+		/// Writes a human readable report of all critical paths with node names and node group paths.
+		void writeReport(std::ostream &stream) const;
+	protected:
+		SignalDelay m_signalDelay;
+		utils::StableMap<Clock*, std::vector<TimingPath>> m_criticalPaths;
+
+		void traceCriticalPath(TimingPath &path, NodePort driver, size_t bit, size_t maxLength);
+};
+
+}
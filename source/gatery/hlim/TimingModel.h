@@ -0,0 +1,46 @@
+/*  This file is part of Gatery, a library for circuit design.
+	Copyright (C) 2021 Michael Offel, Andreas Ley
+
+	Gatery is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	Gatery is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+namespace gtry::hlim {
+
+/**
+ * @brief Delay figures of a target technology, used by the nodes to estimate their signal delays.
+ * @details The defaults are rough, technology agnostic numbers. Target technologies provide device specific tables
+ * (roughly in nanoseconds) through the TimingCapabilities.
+ */
+struct TimingModel {
+	/// Routing delay per signal that has to be brought to a cell.
+	float routingDelay = 0.8f;
+	/// Delay of a single LUT level.
+	float lutDelay = 0.1f;
+	/// Delay per bit of a carry chain (additions, subtractions, and magnitude comparisons).
+	float carryChainDelayPerBit = 0.2f;
+	/// Delay per bit of an equality comparison, which is a LUT reduction instead of a carry chain.
+	float equalityDelayPerBit = 0.15f;
+	/// Delay per additional data input of a multiplexer.
+	float muxDelayPerInput = 0.3f;
+	/// Clock to output delay of a register.
+	float registerClockToOut = 0.0f;
+	/// Clock to output delay of a block RAM read port.
+	float bramClockToOut = 6.0f;
+	/// Clock to output delay of a DSP block, used for multiplications.
+	float dspClockToOut = 6.0f;
+};
+
+}
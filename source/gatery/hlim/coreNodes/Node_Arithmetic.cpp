@@ -246,12 +246,13 @@ void Node_Arithmetic::estimateSignalDelay(SignalDelay &sigDelay)
 
 	auto width = getOutputConnectionType(0).width;
 
+	const auto &timing = sigDelay.getTimingModel();
 
 	switch (m_op) {
 		case ADD:
 		case SUB: {
-			float routing = width * 0.8f;
-			float compute = width * 0.2f;
+			float routing = width * timing.routingDelay;
+			float compute = width * timing.carryChainDelayPerBit;
 
 			// very rough for now
 			float maxDelay = 0.0f;
@@ -263,7 +264,18 @@ void Node_Arithmetic::estimateSignalDelay(SignalDelay &sigDelay)
 				outDelay[i] = maxDelay + routing + compute;
 			}
 		} break;
-		case MUL:
+		case MUL: {
+			// Assume that the multiplication is mapped to DSP blocks
+			float routing = (inDelay0.size() + inDelay1.size()) * timing.routingDelay;
+
+			float maxDelay = 0.0f;
+			for (auto f : inDelay0)
+				maxDelay = std::max(maxDelay, f);
+			for (auto f : inDelay1)
+				maxDelay = std::max(maxDelay, f);
+			for (auto i : utils::Range(width))
+				outDelay[i] = maxDelay + routing + timing.dspClockToOut;
+		} break;
 		case DIV:
 		case REM:
 		default:
@@ -277,20 +289,18 @@ void Node_Arithmetic::estimateSignalDelayCriticalInput(SignalDelay &sigDelay, si
 	auto inDelay0 = sigDelay.getDelay(getDriver(0));
 	auto inDelay1 = sigDelay.getDelay(getDriver(1));
 
-	auto width = getOutputConnectionType(0).width;
-
 	float maxDelay = 0.0f;
 	size_t maxIP = 0;
 	size_t maxIB = 0;
 
-	for (auto i : utils::Range(width))
+	for (auto i : utils::Range(inDelay0.size()))
 		if (inDelay0[i] > maxDelay) {
 			maxDelay = inDelay0[i];
 			maxIP = 0;
 			maxIB = i;
 		}
 
-	for (auto i : utils::Range(width))
+	for (auto i : utils::Range(inDelay1.size()))
 		if (inDelay1[i] > maxDelay) {
 			maxDelay = inDelay1[i];
 			maxIP = 1;
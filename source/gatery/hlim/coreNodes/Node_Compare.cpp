@@ -241,13 +241,15 @@ void Node_Compare::estimateSignalDelay(SignalDelay &sigDelay)
 	auto width = getOutputConnectionType(0).width;
 
 
-	float routing = width * 0.8f;
+	const auto &timing = sigDelay.getTimingModel();
+
+	float routing = width * timing.routingDelay;
 	float compute;
 	
 	if (m_op == EQ || m_op == NEQ)
-		compute = width * 0.15f; // still a reduce, but maybe slightly faster than through half adders
+		compute = width * timing.equalityDelayPerBit; // still a reduce, but maybe slightly faster than through half adders
 	else
-		compute = width * 0.2f; // same as addition/subtraction
+		compute = width * timing.carryChainDelayPerBit; // same as addition/subtraction
 
 	// very rough for now
 	float maxDelay = 0.0f;
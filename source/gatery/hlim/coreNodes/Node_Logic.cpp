@@ -310,14 +310,16 @@ void Node_Logic::estimateSignalDelay(SignalDelay &sigDelay)
 
 	auto width = getOutputConnectionType(0).width;
 
+	const auto &timing = sigDelay.getTimingModel();
+
 	if (m_op == NOT) {
 		for (auto i : utils::Range(width))
-			outDelay[i] = inDelay0[i] + 0.1f;
+			outDelay[i] = inDelay0[i] + timing.lutDelay;
 	} else {
 		auto inDelay1 = sigDelay.getDelay(getDriver(1));
 
-		float routing = 2 * 0.8f;
-		float compute = 0.1f;
+		float routing = 2 * timing.routingDelay;
+		float compute = timing.lutDelay;
 
 		for (auto i : utils::Range(width))
 			outDelay[i] = std::max(inDelay0[i], inDelay1[i]) + routing + compute;
@@ -177,8 +177,9 @@ void Node_Multiplexer::estimateSignalDelay(SignalDelay &sigDelay)
 	auto numInputs = inDelays.size()-1;
 
 	HCL_ASSERT(inDelays.size() >= 2);
-	float routing = (numInputs + selectorBits) * 0.8f;
-	float compute = (numInputs-1) * 0.3f;
+	const auto &timing = sigDelay.getTimingModel();
+	float routing = (numInputs + selectorBits) * timing.routingDelay;
+	float compute = (numInputs-1) * timing.muxDelayPerInput;
 
 	float selectorMax = 0.0f;
 	for (auto &f : inDelays[0])
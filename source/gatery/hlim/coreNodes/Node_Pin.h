@@ -37,6 +37,7 @@ namespace gtry::hlim {
 			bool isInputPin() const { return m_isInputPin; }
 			bool isOutputPin() const { return m_isOutputPin; }
 			bool isBiDirectional() const { return m_isInputPin && m_isOutputPin; }
+			bool hasOutputEnable() const { return m_hasOutputEnable; }
 
 			inline const ConnectionType &getConnectionType() const { return m_connectionType; }
 
@@ -64,8 +65,8 @@ namespace gtry::hlim {
 			void setNormal() { m_differential = false; }
 
 			inline bool isDifferential() const { return m_differential; }
-			inline const std::string &getDifferentialPosName() { return m_differentialPosName; }
-			inline const std::string &getDifferentialNegName() { return m_differentialNegName; }
+			inline const std::string &getDifferentialPosName() const { return m_differentialPosName; }
+			inline const std::string &getDifferentialNegName() const { return m_differentialNegName; }
 
 			 virtual void estimateSignalDelay(SignalDelay &sigDelay) override;
 
@@ -179,7 +179,7 @@ void Node_Register::estimateSignalDelay(SignalDelay &sigDelay)
 	HCL_ASSERT(sigDelay.contains({.node = this, .port = 0ull}));
 	auto outDelay = sigDelay.getDelay({.node = this, .port = 0ull});
 	for (auto &f : outDelay)
-		f = 0.0f;
+		f = sigDelay.getTimingModel().registerClockToOut;
 }
 
 void Node_Register::estimateSignalDelayCriticalInput(SignalDelay &sigDelay, size_t outputPort, size_t outputBit, size_t &inputPort, size_t &inputBit)
@@ -33,71 +33,98 @@ void inferClockDomains(Circuit &circuit, utils::UnstableMap<hlim::NodePort, Sign
 
 	/*
 		Determine clock domains by looking at all nodes in sequence. For some, the clock domain of the outputs can be determined (constants, pins, registers),
-		for others it is dependent on inputs. For the latter, we build a tree-like dependency structure in the "undetermined" map.
-		Whenever a new output is assigned to a clock domain, this map is accessed and if a subtree is dependent on this output it is recursively rechecked.
+		for others it is dependent on inputs. For the latter, we count the drivers that are still undetermined and record the output as a dependent of each driver.
+		Determined outputs are then propagated iteratively through a work list: A dependent output inherits the first non-constant clock domain that reaches it 
+		and becomes constant once all its drivers are determined to be constant.
+		All per-output state lives in dense arrays, indexed by the offset of the node's first output plus the port.
 	*/
-	 
-	utils::UnstableMap<NodePort, std::vector<NodePort>> undetermined;
 
-	std::function<void(const NodePort&, bool)> attemptResolve;
-	std::function<void(const NodePort&, SignalClockDomain)> assignToCD;
+	const auto &nodes = circuit.getNodes();
 
-	assignToCD = [&](const NodePort &np, SignalClockDomain cd){
-		if (domains.contains(np)) return;
-		domains[np] = cd;
+	utils::UnstableMap<const BaseNode*, size_t> firstOutputIdx;
+	size_t numOutputs = 0;
+	for (const auto &n : nodes) {
+		firstOutputIdx[n.get()] = numOutputs;
+		numOutputs += n->getNumOutputPorts();
+	}
+
+	std::vector<SignalClockDomain> outputDomains(numOutputs);
+	std::vector<bool> determined(numOutputs, false);
+	std::vector<size_t> numUndeterminedDrivers(numOutputs, 0);
+	std::vector<size_t> openList;
 
-		auto it = undetermined.find(np);
-		if (it != undetermined.end())
-			for (auto n : it->second)
-				attemptResolve(n, false);
+	auto assignToCD = [&](size_t idx, SignalClockDomain cd) {
+		if (determined[idx]) return;
+		determined[idx] = true;
+		outputDomains[idx] = cd;
+		openList.push_back(idx);
 	};
 
-	attemptResolve = [&](const NodePort &np, bool insertIntoUndetermined){
-		auto ocr = np.node->getOutputClockRelation(np.port);
-		if (ocr.isConst()) 
-			assignToCD(np, {.type = SignalClockDomain::CONSTANT });
-		else {
-			if (!ocr.dependentClocks.empty()) {
+	// (driver, dependent) pairs
+	std::vector<std::pair<size_t, size_t>> dependencies;
+
+	for (const auto &n : nodes) {
+		size_t idx = firstOutputIdx[n.get()];
+		for (auto i : utils::Range(n->getNumOutputPorts())) {
+			auto ocr = n->getOutputClockRelation(i);
+			if (ocr.isConst()) 
+				assignToCD(idx + i, {.type = SignalClockDomain::CONSTANT });
+			else if (!ocr.dependentClocks.empty()) {
 				if (ocr.dependentClocks[0] == nullptr)
-					assignToCD(np, {.type = SignalClockDomain::UNKNOWN });
+					assignToCD(idx + i, {.type = SignalClockDomain::UNKNOWN });
 				else
-					assignToCD(np, {.type = SignalClockDomain::CLOCK, .clk=ocr.dependentClocks[0] });
+					assignToCD(idx + i, {.type = SignalClockDomain::CLOCK, .clk=ocr.dependentClocks[0] });
 			} else {
-				bool allConst = true;
-				for (auto i : ocr.dependentInputs) {
-					auto driver = np.node->getDriver(i);
+				for (auto input : ocr.dependentInputs) {
+					auto driver = n->getDriver(input);
 					if (driver.node == nullptr) continue;
 
-					auto it = domains.find(driver);
-					if (it != domains.end()) {
-						switch (it->second.type) {
-							case SignalClockDomain::CONSTANT:
-							break;
-							case SignalClockDomain::UNKNOWN:
-							case SignalClockDomain::CLOCK:
-								assignToCD(np, it->second);
-								allConst = false;
-							break;
-						}
-					} else {
-						allConst = false;
-						if (insertIntoUndetermined)
-							undetermined[driver].push_back(np);
-					}
+					dependencies.push_back({firstOutputIdx[driver.node] + driver.port, idx + i});
+					numUndeterminedDrivers[idx + i]++;
 				}
 
-				if (allConst)
-					assignToCD(np, {.type = SignalClockDomain::CONSTANT });
+				if (numUndeterminedDrivers[idx + i] == 0)
+					assignToCD(idx + i, {.type = SignalClockDomain::CONSTANT });
 			}
-		}	
-	};
+		}
+	}
 
-	for (auto &n : circuit.getNodes()) {
-		for (auto i : utils::Range(n->getNumOutputPorts())) {
-			NodePort np = {.node = n.get(), .port = i};
-			attemptResolve(np, true);
+	// Sort dependents by driver into a compressed adjacency list
+	std::vector<size_t> dependentsBegin(numOutputs+1, 0);
+	for (const auto &d : dependencies)
+		dependentsBegin[d.first+1]++;
+	for (auto i : utils::Range(numOutputs))
+		dependentsBegin[i+1] += dependentsBegin[i];
+
+	std::vector<size_t> dependents(dependencies.size());
+	{
+		std::vector<size_t> writePos(dependentsBegin.begin(), dependentsBegin.end()-1);
+		for (const auto &d : dependencies)
+			dependents[writePos[d.first]++] = d.second;
+	}
+	dependencies = {};
+
+	while (!openList.empty()) {
+		size_t idx = openList.back();
+		openList.pop_back();
+
+		for (auto depIdx : std::span(dependents.data() + dependentsBegin[idx], dependentsBegin[idx+1] - dependentsBegin[idx])) {
+			if (determined[depIdx]) continue;
+
+			if (outputDomains[idx].type != SignalClockDomain::CONSTANT)
+				assignToCD(depIdx, outputDomains[idx]);
+			else if (--numUndeterminedDrivers[depIdx] == 0)
+				assignToCD(depIdx, {.type = SignalClockDomain::CONSTANT });
 		}
 	}
+
+	// Outputs that remain undetermined are part of loops that are not driven by anything with a clock domain.
+	for (const auto &n : nodes) {
+		size_t idx = firstOutputIdx[n.get()];
+		for (auto i : utils::Range(n->getNumOutputPorts()))
+			if (determined[idx + i])
+				domains[{.node = n.get(), .port = i}] = outputDomains[idx + i];
+	}
 }
 
 
@@ -126,4 +153,13 @@ void detectUnguardedCDCCrossings(Circuit &circuit, const ConstSubnet &subnet, st
 	}
 }
 
+std::vector<const BaseNode*> findUnguardedCDCCrossings(Circuit &circuit, const ConstSubnet &subnet)
+{
+	std::vector<const BaseNode*> affectedNodes;
+	detectUnguardedCDCCrossings(circuit, subnet, [&](const BaseNode *affectedNode) {
+		affectedNodes.push_back(affectedNode);
+	});
+	return affectedNodes;
+}
+
 }
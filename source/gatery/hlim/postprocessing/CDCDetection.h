@@ -39,5 +39,8 @@ void inferClockDomains(Circuit &circuit, utils::UnstableMap<hlim::NodePort, Sign
 
 void detectUnguardedCDCCrossings(Circuit &circuit, const ConstSubnet &subnet, std::function<void(const BaseNode*)> detectionCallback);
 
+/// Returns all nodes in the subnet with unintentional clock domain crossings on their inputs.
+std::vector<const BaseNode*> findUnguardedCDCCrossings(Circuit &circuit, const ConstSubnet &subnet);
+
 
 }
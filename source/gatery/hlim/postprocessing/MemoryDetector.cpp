@@ -50,6 +50,7 @@
 #endif
 
 #include "../../debug/DebugInterface.h"
+#include "../../utils/Parallel.h"
 
 #include <iostream>
 #include <sstream>
@@ -59,10 +60,12 @@
 
 namespace gtry::hlim {
 
-MemoryGroup *formMemoryGroupIfNecessary(Circuit &circuit, Node_Memory *memory)
+static MemoryGroup *formMemoryGroupIfNecessary(Circuit &circuit, Node_Memory *memory, const MemoryGroup::PortIndex *portIndex)
 {
 	auto* memoryGroup = dynamic_cast<MemoryGroup*>(memory->getGroup()->getMetaInfo());
 	if (memoryGroup == nullptr) {
+		auto start = std::chrono::steady_clock::now();
+
 		dbg::log(dbg::LogMessage() << dbg::LogMessage::LOG_INFO << dbg::LogMessage::LOG_POSTPROCESSING << "Forming memory group around " << memory);
 
 		HCL_ASSERT(memory->getGroup()->getMetaInfo() == nullptr);		
@@ -75,16 +78,38 @@ MemoryGroup *formMemoryGroupIfNecessary(Circuit &circuit, Node_Memory *memory)
 		memory->moveToGroup(physMemNodeGroup);
 
 		memoryGroup = memory->getGroup()->createMetaInfo<MemoryGroup>(memory->getGroup());
-		memoryGroup->pullInPorts(memory);
+		if (portIndex)
+			memoryGroup->pullInPorts(memory, *portIndex);
+		else
+			memoryGroup->pullInPorts(memory);
+
+		memoryGroup->addProcessingTime(std::chrono::steady_clock::now() - start);
 	}
 	return memoryGroup;
 }
 
+MemoryGroup *formMemoryGroupIfNecessary(Circuit &circuit, Node_Memory *memory)
+{
+	return formMemoryGroupIfNecessary(circuit, memory, nullptr);
+}
+
 void findMemoryGroups(Circuit &circuit)
 {
+	std::vector<Node_Memory*> memories;
 	for (auto &node : circuit.getNodes())
 		if (auto *memory = dynamic_cast<Node_Memory*>(node.get()))
-			formMemoryGroupIfNecessary(circuit, memory);
+			if (dynamic_cast<MemoryGroup*>(memory->getGroup()->getMetaInfo()) == nullptr)
+				memories.push_back(memory);
+
+	// Gathering and checking the ports does not modify the circuit and can happen for all memories in parallel.
+	std::vector<MemoryGroup::PortIndex> portIndices(memories.size());
+	utils::parallelFor(memories.size(), [&](size_t i) {
+		portIndices[i] = MemoryGroup::PortIndex::build(memories[i]);
+	});
+
+	// Forming the groups moves nodes and must happen serially.
+	for (auto i : utils::Range(memories.size()))
+		formMemoryGroupIfNecessary(circuit, memories[i], &portIndices[i]);
 }
 
 
@@ -168,70 +193,79 @@ MemoryGroup::MemoryGroup(NodeGroup *group) : m_nodeGroup(group)
 
 const MemoryGroup::ReadPort &MemoryGroup::findReadPort(Node_MemPort *memPort)
 {
-	for (auto &rp : m_readPorts)
-		if (rp.node == memPort)
-			return rp;
-		
-	HCL_ASSERT(false);
+	auto it = m_readPortIdx.find(memPort);
+	HCL_ASSERT(it != m_readPortIdx.end());
+	return m_readPorts[it->second];
 }
 
 const MemoryGroup::WritePort &MemoryGroup::findWritePort(Node_MemPort *memPort)
 {
-	for (auto &wp : m_writePorts)
-		if (wp.node == memPort)
-			return wp;
-		
-	HCL_ASSERT(false);
+	auto it = m_writePortIdx.find(memPort);
+	HCL_ASSERT(it != m_writePortIdx.end());
+	return m_writePorts[it->second];
+}
+
+MemoryGroup::PortIndex MemoryGroup::PortIndex::build(Node_Memory *memory)
+{
+	PortIndex index;
+
+	for (auto &np : memory->getPorts()) {
+		auto *port = dynamic_cast<Node_MemPort*>(np.node);
+		HCL_ASSERT(port->isWritePort() || port->isReadPort());
+		index.ports.push_back(port);
+		if (port->isWritePort()) {
+			HCL_ASSERT_HINT(!port->isReadPort(), "For now I don't want to mix read and write ports");
+			index.writePorts.push_back(port);
+		}
+		if (port->isReadPort())
+			index.readPorts.push_back(port);
+	}
+
+	// Verify writing is only happening with one clock:
+	for (auto *port : index.writePorts)
+		if (index.writePorts.front()->getClocks()[0] != port->getClocks()[0]) {
+			std::stringstream issues;
+			issues << "All write ports to a memory must have the same clock!\n";
+			issues << "from:\n" << index.writePorts.front()->getStackTrace() << "\n and from:\n" << port->getStackTrace();
+			HCL_DESIGNCHECK_HINT(false, issues.str());
+		}
+
+	return index;
 }
 
 void MemoryGroup::pullInPorts(Node_Memory *memory)
+{
+	pullInPorts(memory, PortIndex::build(memory));
+}
+
+void MemoryGroup::pullInPorts(Node_Memory *memory, const PortIndex &portIndex)
 {
 	m_memory = memory;
 
+	m_writePorts.reserve(portIndex.writePorts.size());
+	m_readPorts.reserve(portIndex.readPorts.size());
+
 	// Initial naive grabbing of everything that might be usefull
-	for (auto &np : m_memory->getPorts()) {
-		auto *port = dynamic_cast<Node_MemPort*>(np.node);
-		HCL_ASSERT(port->isWritePort() || port->isReadPort());
+	for (auto *port : portIndex.ports) {
 		// Check all write ports
 		if (port->isWritePort()) {
-			HCL_ASSERT_HINT(!port->isReadPort(), "For now I don't want to mix read and write ports");
+			m_writePortIdx[port] = m_writePorts.size();
 			m_writePorts.push_back({.node=NodePtr<Node_MemPort>{port}});
 			port->moveToGroup(m_nodeGroup);
 		}
 		// Check all read ports
 		if (port->isReadPort()) {
+			m_readPortIdx[port] = m_readPorts.size();
 			m_readPorts.push_back({.node = NodePtr<Node_MemPort>{port}});
 			ReadPort &rp = m_readPorts.back();
 			port->moveToGroup(m_nodeGroup);
 			rp.dataOutput = {.node = port, .port = (size_t)Node_MemPort::Outputs::rdData};
 
-			//NodePort readPortEnable = port->getNonSignalDriver((size_t)Node_MemPort::Inputs::enable);
-
 			// Try and grab as many output registers as possible (up to read latency)
 			// rp.findOutputRegisters(m_memory->getRequiredReadLatency(), this);
 			// Actually, don't do this yet, makes things easier
 		}
 	}
-
-	// Verify writing is only happening with one clock:
-	{
-		Node_MemPort *firstWritePort = nullptr;
-		for (auto &np : m_memory->getPorts()) {
-			auto *port = dynamic_cast<Node_MemPort*>(np.node);
-			if (port->isWritePort()) {
-				if (firstWritePort == nullptr)
-					firstWritePort = port;
-				else {
-					if (firstWritePort->getClocks()[0] != port->getClocks()[0]) {
-						std::stringstream issues;
-						issues << "All write ports to a memory must have the same clock!\n";
-						issues << "from:\n" << firstWritePort->getStackTrace() << "\n and from:\n" << port->getStackTrace();
-						HCL_DESIGNCHECK_HINT(false, issues.str());
-					}
-				}
-			}
-		}
-	}
 }
 
 NodeGroup *MemoryGroup::lazyCreateFixupNodeGroup()
@@ -303,7 +337,7 @@ void MemoryGroup::convertToReadBeforeWrite(Circuit &circuit)
 				// Actually: Don't fetch them beforehand, makes things easier
 				HCL_ASSERT(rp.dedicatedReadLatencyRegisters.empty());
 
-				std::vector<NodePort> consumers = rp.dataOutput.node->getDirectlyDriven(rp.dataOutput.port);
+				NodeIO::ConsumerList consumers = rp.dataOutput.node->getDirectlyDriven(rp.dataOutput.port);
 
 				// Finally the actual mux to arbitrate between the actual read and the forwarded write data.
 				auto *muxNode = circuit.createNode<Node_Multiplexer>(2);
@@ -1266,6 +1300,8 @@ void MemoryGroup::replaceWithIOPins(Circuit &circuit)
 
 	m_readPorts.clear();
 	m_writePorts.clear();
+	m_readPortIdx.clear();
+	m_writePortIdx.clear();
 	m_memory = nullptr;
 }
 
@@ -1290,6 +1326,11 @@ Memory2VHDLPattern::Memory2VHDLPattern()
 	m_priority = EXPORT_LANGUAGE_MAPPING + 100;
 }
 
+bool Memory2VHDLPattern::canApply(const hlim::NodeGroup *nodeGroup) const
+{
+	return dynamic_cast<const MemoryGroup*>(nodeGroup->getMetaInfo()) != nullptr;
+}
+
 bool Memory2VHDLPattern::attemptApply(Circuit &circuit, hlim::NodeGroup *nodeGroup) const
 {
 	auto* memoryGroup = dynamic_cast<MemoryGroup*>(nodeGroup->getMetaInfo());
@@ -1299,6 +1340,8 @@ bool Memory2VHDLPattern::attemptApply(Circuit &circuit, hlim::NodeGroup *nodeGro
 
 	dbg::log(dbg::LogMessage() << dbg::LogMessage::LOG_INFO << dbg::LogMessage::LOG_TECHNOLOGY_MAPPING << "Preparing memory in " << nodeGroup << " for vhdl export");
 
+	auto start = std::chrono::steady_clock::now();
+
 	memoryGroup->convertToReadBeforeWrite(circuit);
 	memoryGroup->attemptRegisterRetiming(circuit);
 	memoryGroup->resolveWriteOrder(circuit);
@@ -1313,6 +1356,10 @@ bool Memory2VHDLPattern::attemptApply(Circuit &circuit, hlim::NodeGroup *nodeGro
 		nodeGroup->getParent()->properties()["primitive"] = "vhdl";
 	}
 
+	memoryGroup->addProcessingTime(std::chrono::steady_clock::now() - start);
+	dbg::log(dbg::LogMessage() << dbg::LogMessage::LOG_INFO << dbg::LogMessage::LOG_POSTPROCESSING << "Processing memory in " << nodeGroup << " took " 
+		<< std::chrono::duration_cast<std::chrono::microseconds>(memoryGroup->getProcessingTime()).count() << " us");
+
 	return true;
 }
 
@@ -23,6 +23,11 @@
 
 #include "TechnologyMapping.h"
 
+#include <gatery/utils/StableContainers.h>
+
+#include <chrono>
+#include <vector>
+
 namespace gtry::hlim {
 
 class Circuit;
@@ -46,9 +51,20 @@ class MemoryGroup : public NodeGroupMetaInfo
 			bool findOutputRegisters(size_t readLatency, NodeGroup *memoryNodeGroup);
 		};
 
+		/// Read and write ports of a memory, gathered without modifying the circuit so that it can be built for many memories in parallel.
+		struct PortIndex {
+			/// All ports in the order of the memory's ports
+			std::vector<Node_MemPort*> ports;
+			std::vector<Node_MemPort*> writePorts;
+			std::vector<Node_MemPort*> readPorts;
+
+			static PortIndex build(Node_Memory *memory);
+		};
+
 		MemoryGroup(NodeGroup *group);
 		
 		void pullInPorts(Node_Memory *memory);
+		void pullInPorts(Node_Memory *memory, const PortIndex &portIndex);
 
 		void convertToReadBeforeWrite(Circuit &circuit);
 		void resolveWriteOrder(Circuit &circuit);
@@ -70,10 +86,17 @@ class MemoryGroup : public NodeGroupMetaInfo
 
 		inline NodeGroup *getNodeGroup() const { return m_nodeGroup; }
 		inline NodeGroup *getFixupNodeGroup() const { return m_fixupNodeGroup; }
+
+		/// Accumulated time spent detecting and processing this memory during postprocessing.
+		inline std::chrono::steady_clock::duration getProcessingTime() const { return m_processingTime; }
+		inline void addProcessingTime(std::chrono::steady_clock::duration duration) { m_processingTime += duration; }
 	protected:
 		NodePtr<Node_Memory> m_memory;
 		std::vector<WritePort> m_writePorts;
 		std::vector<ReadPort> m_readPorts;
+		utils::UnstableMap<Node_MemPort*, size_t> m_writePortIdx;
+		utils::UnstableMap<Node_MemPort*, size_t> m_readPortIdx;
+		std::chrono::steady_clock::duration m_processingTime = {};
 
 		NodeGroup *m_nodeGroup;
 		NodeGroup *m_fixupNodeGroup = nullptr;
@@ -99,6 +122,7 @@ class MemoryGroup : public NodeGroupMetaInfo
 	{
 		public:
 			Memory2VHDLPattern();
+			virtual bool canApply(const hlim::NodeGroup *nodeGroup) const override;
 			virtual bool attemptApply(Circuit &circuit, hlim::NodeGroup *nodeGroup) const override;
 	};
 
@@ -17,15 +17,19 @@
 */
 #include "gatery/pch.h"
 
-#include "OverrideResolution.h"
+#include "Retiming.h"
 
 #include "../supportNodes/Node_RegSpawner.h"
 #include "../supportNodes/Node_RegHint.h"
 #include "../supportNodes/Node_RetimingBlocker.h"
 
+#include "../coreNodes/Node_Register.h"
+
 #include "../Circuit.h"
+#include "../Clock.h"
 #include "../RegisterRetiming.h"
 #include "../GraphTools.h"
+#include "../SignalDelay.h"
 
 #include "../../export/DotExport.h"
 
@@ -36,7 +40,7 @@
 namespace gtry::hlim {
 
 
-void resolveRetimingHints(Circuit &circuit, Subnet &subnet)
+void resolveRetimingHints(Circuit &circuit, Subnet &subnet, const TimingModel &timingModel)
 {
 	// Locate all spawners in subnet
 	std::vector<Node_RegSpawner*> spawner;
@@ -82,11 +86,104 @@ void resolveRetimingHints(Circuit &circuit, Subnet &subnet)
 		node->bypassOutputToInput(0, 0);
 	}
 
+	for (auto *regSpawner : spawner)
+		if (regSpawner->getAutoPipelining() && regSpawner->getClocks()[0] != nullptr)
+			autoPipelineRegSpawner(circuit, subnet, regSpawner, timingModel);
+
 	for (auto *regSpawner : spawner)
 		regSpawner->markResolved();
 
 }
 
+bool autoPipelineRegSpawner(Circuit &circuit, Subnet &subnet, Node_RegSpawner *spawner, const TimingModel &timingModel)
+{
+	const auto &settings = *spawner->getAutoPipelining();
+	ClockRational frequency = settings.targetFrequency ? *settings.targetFrequency : spawner->getClocks()[0]->absoluteFrequency();
+	float period = (float) toNanoseconds(ClockRational(1, 1) / frequency);
+
+	// Everything that is combinatorically driven by the spawner is what the stages can be distributed over.
+	// Registers placed by the retiming become part of it but are not crossed when searching for the critical path.
+	std::vector<NodePort> spawnerOutputs;
+	for (auto i : utils::Range(spawner->getNumOutputPorts()))
+		spawnerOutputs.push_back({.node = spawner, .port = i});
+	Subnet pipeline = Subnet::allDrivenCombinatoricallyByOutputs(spawnerOutputs);
+
+	SignalDelay delays(timingModel);
+	delays.compute(subnet);
+
+	// Retiming may also just move existing registers forward, so bound the number of attempts by the pipeline size.
+	size_t maxAttempts = pipeline.getNodes().size();
+	for (size_t attempt = 0; attempt < maxAttempts; attempt++) {
+
+		// Find critical output
+		NodePort criticalOutput;
+		size_t criticalBit = ~0ull;
+		float criticalTime = 0.0f;
+		for (auto n : pipeline) {
+			if (!subnet.contains(n)) continue;
+			for (auto i : utils::Range(n->getNumOutputPorts())) {
+				NodePort np = {.node = n, .port = i};
+				auto d = delays.getDelay(np);
+				for (auto b : utils::Range(d.size()))
+					if (d[b] > criticalTime) {
+						criticalTime = d[b];
+						criticalOutput = np;
+						criticalBit = b;
+					}
+			}
+		}
+
+		if (criticalTime <= period)
+			return true;
+
+		if (spawner->getNumStagesSpawned() >= settings.latencyBudget) {
+			std::cout << "WARNING: Auto pipelining of register spawner " << spawner->getId() << " exhausted its latency budget of " << settings.latencyBudget 
+				<< " stages with an estimated critical path of " << criticalTime << " ns (target " << period << " ns)." << std::endl;
+			return false;
+		}
+
+		// Trace back the critical path to the latest output that still meets timing and place the next stage there.
+		NodePort retimingTarget;
+		{
+			NodePort np = criticalOutput;
+			size_t bit = criticalBit;
+			while (np.node != nullptr && pipeline.contains(np.node) && subnet.contains(np.node)) {
+				if (np.node == spawner || dynamic_cast<Node_Register*>(np.node)) break;
+
+				if (delays.getDelay(np)[bit] <= period) {
+					retimingTarget = np;
+					break;
+				}
+
+				size_t criticalInputPort, criticalInputBit;
+				np.node->estimateSignalDelayCriticalInput(delays, np.port, bit, criticalInputPort, criticalInputBit);
+				if (criticalInputPort == ~0u) break;
+
+				np = np.node->getDriver(criticalInputPort);
+				bit = criticalInputBit;
+			}
+		}
+
+		Subnet changedNodes;
+		Subnet rewiredNodes;
+		if (retimingTarget.node == nullptr || 
+				!retimeForwardToOutput(circuit, subnet, retimingTarget, {.failureIsError=false, .newNodes=&changedNodes, .rewiredNodes=&rewiredNodes, .downstreamDisableForwardRT=true})) {
+
+			std::cout << "WARNING: Auto pipelining of register spawner " << spawner->getId() << " can not split the critical path of " 
+				<< criticalTime << " ns any further (target " << period << " ns)." << std::endl;
+			return false;
+		}
+
+		for (auto n : changedNodes)
+			pipeline.add(n);
+		for (auto n : rewiredNodes)
+			changedNodes.add(n);
+		delays.update(subnet, changedNodes);
+	}
+
+	return false;
+}
+
 void bypassRetimingBlockers(Circuit &circuit, Subnet &subnet)
 {
 	for (auto &n : subnet)
@@ -17,12 +17,27 @@
 */
 #pragma once
 
+#include "../TimingModel.h"
+
 namespace gtry::hlim {
 
 class Circuit;
 class Subnet;
-
-void resolveRetimingHints(Circuit &circuit, Subnet &subnet);
+class Node_RegSpawner;
+
+/**
+ * @brief Resolves all register hints and spawners in the subnet.
+ * @details Register hints are resolved first, then register spawners that have auto pipelining enabled spawn
+ * additional stages based on the given timing model.
+ */
+void resolveRetimingHints(Circuit &circuit, Subnet &subnet, const TimingModel &timingModel = {});
+
+/**
+ * @brief Spawns register stages from the spawner and retimes them onto the critical paths downstream of it until every stage meets the target frequency.
+ * @details Stops early if the latency budget is exhausted or if the critical path can not be split any further.
+ * @returns Whether all stages meet the target frequency.
+ */
+bool autoPipelineRegSpawner(Circuit &circuit, Subnet &subnet, Node_RegSpawner *spawner, const TimingModel &timingModel);
 
 void bypassRetimingBlockers(Circuit &circuit, Subnet &subnet);
 
@@ -24,6 +24,9 @@
 #include "../NodeGroup.h"
 #include "../Circuit.h"
 
+#include "../../utils/Parallel.h"
+#include "../../utils/Range.h"
+
 namespace gtry::hlim {
 
 
@@ -43,14 +46,83 @@ void TechnologyMapping::addPattern(std::unique_ptr<TechnologyMappingPattern> pat
 	std::sort(m_patterns.begin(), m_patterns.end(), [](const auto &lhs, const auto &rhs)->bool{
 		return lhs->getPriority() < rhs->getPriority();
 	});
+
+	m_patternsByGroupName.clear();
+	m_unrestrictedPatterns.clear();
+	for (auto i : utils::Range(m_patterns.size())) {
+		auto name = m_patterns[i]->getRequiredGroupName();
+		if (name.empty())
+			m_unrestrictedPatterns.push_back(i);
+		else
+			m_patternsByGroupName[std::string(name)].push_back(i);
+	}
 }
 
+void TechnologyMapping::findCandidates(const hlim::NodeGroup *nodeGroup, Candidates &candidates) const
+{
+	candidates.clear();
+
+	const std::vector<size_t> *restricted = nullptr;
+	auto it = m_patternsByGroupName.find(nodeGroup->getName());
+	if (it != m_patternsByGroupName.end())
+		restricted = &it->second;
+
+	// Merge both lists to keep the order of priorities
+	size_t i = 0, j = 0;
+	while (i < m_unrestrictedPatterns.size() || (restricted && j < restricted->size())) {
+		size_t idx;
+		if (restricted == nullptr || j == restricted->size() || (i < m_unrestrictedPatterns.size() && m_unrestrictedPatterns[i] < (*restricted)[j]))
+			idx = m_unrestrictedPatterns[i++];
+		else
+			idx = (*restricted)[j++];
+
+		if (m_patterns[idx]->canApply(nodeGroup))
+			candidates.push_back(m_patterns[idx].get());
+	}
+}
 
 void TechnologyMapping::apply(Circuit &circuit, hlim::NodeGroup *nodeGroup) const
 {
+	std::vector<const hlim::NodeGroup*> groups;
+	{
+		std::vector<const hlim::NodeGroup*> stack = { nodeGroup };
+		while (!stack.empty()) {
+			auto *group = stack.back();
+			stack.pop_back();
+			groups.push_back(group);
+			for (const auto &c : group->getChildren())
+				stack.push_back(c.get());
+		}
+	}
+
+	std::vector<Candidates> candidates(groups.size());
+	utils::parallelFor(groups.size(), [&](size_t i) {
+		findCandidates(groups[i], candidates[i]);
+	});
+
+	utils::UnstableMap<std::uint64_t, Candidates> candidatesByGroup;
+	for (auto i : utils::Range(groups.size()))
+		candidatesByGroup[groups[i]->getId()] = std::move(candidates[i]);
+
+	apply(circuit, nodeGroup, candidatesByGroup);
+}
+
+void TechnologyMapping::apply(Circuit &circuit, hlim::NodeGroup *nodeGroup, const utils::UnstableMap<std::uint64_t, Candidates> &candidatesByGroup) const
+{
+	// Groups that were created by previously applied patterns were not matched yet.
+	Candidates newGroupCandidates;
+	const Candidates *candidates;
+	auto it = candidatesByGroup.find(nodeGroup->getId());
+	if (it != candidatesByGroup.end())
+		candidates = &it->second;
+	else {
+		findCandidates(nodeGroup, newGroupCandidates);
+		candidates = &newGroupCandidates;
+	}
+
 	bool handled = false;
 	{
-		for (auto &pattern : m_patterns)
+		for (auto *pattern : *candidates)
 			if (pattern->attemptApply(circuit, nodeGroup)) {
 				handled = true;
 				break;
@@ -60,10 +132,9 @@ void TechnologyMapping::apply(Circuit &circuit, hlim::NodeGroup *nodeGroup) cons
 	if (!handled)
 		for (size_t i = 0; i < nodeGroup->getChildren().size(); i++) {
 			auto &g = nodeGroup->getChildren()[i];
-			apply(circuit, g.get());
+			apply(circuit, g.get(), candidatesByGroup);
 		}
 }
 
 
 }
-
@@ -17,8 +17,14 @@
 */
 #pragma once
 
+#include <gatery/utils/StableContainers.h>
+
+#include <cstdint>
+#include <map>
 #include <vector>
 #include <memory>
+#include <string>
+#include <string_view>
 
 namespace gtry::hlim {
 	class NodeGroup;
@@ -36,8 +42,17 @@ namespace gtry::hlim {
 			TechnologyMappingPattern();
 			virtual ~TechnologyMappingPattern() = default;
 
+			/**
+			 * @brief Cheap check whether attemptApply could possibly succeed on the given node group.
+			 * @details Must not modify anything since it is run in parallel on many node groups. Returning true does not
+			 * guarantee that attemptApply will succeed, but returning false must guarantee that it fails.
+			 */
+			virtual bool canApply(const hlim::NodeGroup *nodeGroup) const { return true; }
 			virtual bool attemptApply(Circuit &circuit, hlim::NodeGroup *nodeGroup) const = 0;
 
+			/// If not empty, the pattern is only tried on node groups of this name.
+			virtual std::string_view getRequiredGroupName() const { return {}; }
+
 			inline size_t getPriority() const { return m_priority; }
 		protected:
 			size_t m_priority = TECH_MAPPING + 100;
@@ -50,9 +65,23 @@ namespace gtry::hlim {
 
 			void addPattern(std::unique_ptr<TechnologyMappingPattern> pattern);
 
+			/**
+			 * @brief Applies the patterns to the node group and, recursively, to all children of groups that were not handled.
+			 * @details First, the patterns that can apply are determined for all node groups in parallel without modifying the circuit. 
+			 * Afterwards, the patterns are applied serially in the same order as a purely serial traversal would.
+			 */
 			void apply(Circuit &circuit, hlim::NodeGroup *nodeGroup) const;
 		protected:
 			std::vector<std::unique_ptr<TechnologyMappingPattern>> m_patterns;
+			/// Indices into m_patterns of the patterns that are restricted to a group name.
+			std::map<std::string, std::vector<size_t>, std::less<>> m_patternsByGroupName;
+			/// Indices into m_patterns of the patterns that are tried on all groups.
+			std::vector<size_t> m_unrestrictedPatterns;
+
+			using Candidates = std::vector<const TechnologyMappingPattern*>;
+
+			void findCandidates(const hlim::NodeGroup *nodeGroup, Candidates &candidates) const;
+			void apply(Circuit &circuit, hlim::NodeGroup *nodeGroup, const utils::UnstableMap<std::uint64_t, Candidates> &candidatesByGroup) const;
 	};
 
 
@@ -437,8 +437,8 @@ void Node_MemPort::estimateSignalDelay(SignalDelay &sigDelay)
 
 		auto width = getOutputConnectionType((size_t)Outputs::rdData).width;
 
-		float routing = totalInSignals * 0.8f;
-		float compute = 6.0f;
+		float routing = totalInSignals * sigDelay.getTimingModel().routingDelay;
+		float compute = sigDelay.getTimingModel().bramClockToOut;
 
 		float maxDelay = 0.0f;
 		for (auto f : enableDelay)
@@ -164,6 +164,7 @@ std::unique_ptr<BaseNode> Node_RegSpawner::cloneUnconnected() const
 {
 	std::unique_ptr<BaseNode> copy(new Node_RegSpawner());
 	copyBaseToClone(copy.get());
+	((Node_RegSpawner*)copy.get())->m_autoPipelining = m_autoPipelining;
 
 	return copy;
 }
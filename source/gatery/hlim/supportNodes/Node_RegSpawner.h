@@ -18,6 +18,9 @@
 #pragma once
 
 #include "../Node.h"
+#include "../ClockRational.h"
+
+#include <optional>
 
 
 namespace gtry::hlim {
@@ -37,6 +40,13 @@ class Node_RegSpawner : public Node<Node_RegSpawner>
 			INPUT_SIGNAL_OFFSET
 		};
 
+		struct AutoPipelining {
+			/// Maximum number of register stages that the spawner may spawn in total.
+			size_t latencyBudget = 0;
+			/// Frequency that each stage has to meet, defaults to the frequency of the spawner's clock.
+			std::optional<ClockRational> targetFrequency;
+		};
+
 		Node_RegSpawner();
 
 		virtual void simulateEvaluate(sim::SimulatorCallbacks &simCallbacks, sim::DefaultBitVectorState &state, const size_t *internalOffsets, const size_t *inputOffsets, const size_t *outputOffsets) const override;
@@ -67,9 +77,14 @@ class Node_RegSpawner : public Node<Node_RegSpawner>
 		virtual void estimateSignalDelayCriticalInput(SignalDelay &sigDelay, size_t outputPort, size_t outputBit, size_t &inputPort, size_t &inputBit) override;
 
 		inline size_t getNumStagesSpawned() const { return m_numStagesSpawned; }
+
+		/// Lets the postprocessing spawn as many stages (within the budget) as needed to meet timing.
+		inline void setAutoPipelining(const AutoPipelining &settings) { m_autoPipelining = settings; }
+		inline const std::optional<AutoPipelining> &getAutoPipelining() const { return m_autoPipelining; }
 	protected:
 		size_t m_numStagesSpawned = 0ull;
 		bool m_wasResolved = false;
+		std::optional<AutoPipelining> m_autoPipelining;
 };
 
 }
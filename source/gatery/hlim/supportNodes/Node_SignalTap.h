@@ -54,6 +54,7 @@ class Node_SignalTap : public Node<Node_SignalTap>
 		
 		void addInput(hlim::NodePort input);
 		inline void addMessagePart(LogMessagePart part) { m_logMessage.push_back(std::move(part)); }
+		inline const std::vector<LogMessagePart> &getMessageParts() const { return m_logMessage; }
 		
 		virtual void simulateCommit(sim::SimulatorCallbacks &simCallbacks, sim::DefaultBitVectorState &state, const size_t *internalOffsets, const size_t *inputOffsets) const override;
 		
@@ -31,6 +31,7 @@ class BaseDDROutPattern : public TechnologyMappingPattern
 	public:
 		virtual ~BaseDDROutPattern() = default;
 
+		virtual std::string_view getRequiredGroupName() const override { return "scl_oddr"; }
 		bool scopedAttemptApply(hlim::NodeGroup *nodeGroup) const;
 	protected:
 		std::string_view m_patternName;
@@ -138,6 +138,11 @@ const EmbeddedMemory *EmbeddedMemoryList::selectMemFor(hlim::NodeGroup *group, G
 }
 
 
+bool EmbeddedMemoryPattern::canApply(const hlim::NodeGroup *nodeGroup) const
+{
+	return dynamic_cast<const hlim::MemoryGroup*>(nodeGroup->getMetaInfo()) != nullptr;
+}
+
 bool EmbeddedMemoryPattern::scopedAttemptApply(hlim::NodeGroup *nodeGroup) const
 {
 	auto *memGrp = dynamic_cast<hlim::MemoryGroup*>(nodeGroup->getMetaInfo());
@@ -97,6 +97,7 @@ class EmbeddedMemoryPattern : public TechnologyMappingPattern
 		EmbeddedMemoryPattern(const FPGADevice &targetDevice) : m_targetDevice(targetDevice) { }
 		virtual ~EmbeddedMemoryPattern() = default;
 
+		virtual bool canApply(const hlim::NodeGroup *nodeGroup) const override;
 		virtual bool scopedAttemptApply(hlim::NodeGroup *nodeGroup) const override;
 	protected:
 		const FPGADevice &m_targetDevice;
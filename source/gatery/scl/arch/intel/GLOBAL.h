@@ -40,6 +40,7 @@ class GLOBALPattern : public TechnologyMappingPattern
 	public:
 		virtual ~GLOBALPattern() = default;
 
+		virtual std::string_view getRequiredGroupName() const override { return "scl_globalBuffer"; }
 		virtual bool scopedAttemptApply(hlim::NodeGroup *nodeGroup) const override;
 	protected:
 };
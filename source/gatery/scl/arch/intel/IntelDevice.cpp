@@ -36,6 +36,28 @@
 
 namespace gtry::scl::arch::intel {
 
+// Rough delay tables (in ns) of the mid speed grades. These are only meant for quick timing estimates, not for sign-off.
+static const hlim::TimingModel timingHighEnd = {
+	.routingDelay = 0.4f,
+	.lutDelay = 0.15f,
+	.carryChainDelayPerBit = 0.03f,
+	.equalityDelayPerBit = 0.05f,
+	.muxDelayPerInput = 0.1f,
+	.registerClockToOut = 0.2f,
+	.bramClockToOut = 1.2f,
+	.dspClockToOut = 2.5f,
+};
+
+static const hlim::TimingModel timingLowCost = {
+	.routingDelay = 0.7f,
+	.lutDelay = 0.25f,
+	.carryChainDelayPerBit = 0.06f,
+	.equalityDelayPerBit = 0.09f,
+	.muxDelayPerInput = 0.18f,
+	.registerClockToOut = 0.5f,
+	.bramClockToOut = 2.5f,
+	.dspClockToOut = 4.0f,
+};
 
 
 struct AgilexDeviceString {
@@ -291,6 +313,7 @@ void IntelDevice::setupDevice(std::string device)
 
 	if (agilexDevStr.parse(m_device)) {
 		m_family = "Agilex";
+		m_timingCaps.setTimingModel(timingHighEnd);
 
 		bool add_eSRAM = false;
 		bool add_crypto = false;
@@ -337,6 +360,7 @@ void IntelDevice::setupDevice(std::string device)
 
 	} else if (arria10DevStr.parse(m_device)) {
 		m_family = "Arria 10";
+		m_timingCaps.setTimingModel(timingHighEnd);
 
 		m_embeddedMemoryList->add(std::make_unique<MLAB>(*this));
 		m_embeddedMemoryList->add(std::make_unique<M20K>(*this));
@@ -346,6 +370,7 @@ void IntelDevice::setupDevice(std::string device)
 
 	} else if (stratix10DevStr.parse(m_device)) {
 		m_family = "Stratix 10";
+		m_timingCaps.setTimingModel(timingHighEnd);
 
 		m_embeddedMemoryList->add(std::make_unique<MLAB>(*this));
 		m_embeddedMemoryList->add(std::make_unique<M20K>(*this));
@@ -357,10 +382,12 @@ void IntelDevice::setupDevice(std::string device)
 
 		if (cyclone10DevStr.variant == Cyclone10DeviceString::GX) {
 			m_family = "Cyclone 10 GX";
+			m_timingCaps.setTimingModel(timingHighEnd);
 			m_embeddedMemoryList->add(std::make_unique<MLAB>(*this));
 			m_embeddedMemoryList->add(std::make_unique<M20K>(*this));
 		} else {
 			m_family = "Cyclone 10 LP";
+			m_timingCaps.setTimingModel(timingLowCost);
 			m_embeddedMemoryList->add(std::make_unique<M9K>(*this));
 		}
 		m_technologyMapping.addPattern(std::make_unique<GLOBALPattern>());
@@ -369,6 +396,7 @@ void IntelDevice::setupDevice(std::string device)
 
 	} else if (max10DevStr.parse(m_device)) {
 		m_family = "MAX 10";
+		m_timingCaps.setTimingModel(timingLowCost);
 
 		m_embeddedMemoryList->add(std::make_unique<M9K>(*this));
 		m_technologyMapping.addPattern(std::make_unique<GLOBALPattern>());
@@ -49,6 +49,7 @@ class TRIPattern : public TechnologyMappingPattern
 	public:
 		virtual ~TRIPattern() = default;
 
+		virtual std::string_view getRequiredGroupName() const override { return "scl_tristate_output"; }
 		virtual bool scopedAttemptApply(hlim::NodeGroup *nodeGroup) const override;
 	protected:
 };
@@ -26,6 +26,12 @@
 
 namespace gtry::scl::arch::xilinx {
 
+bool FifoPattern::canApply(const hlim::NodeGroup *nodeGroup) const
+{
+	const auto *meta = dynamic_cast<const FifoMeta*>(nodeGroup->getMetaInfo());
+	return meta != nullptr && meta->fifoChoice.singleClock;
+}
+
 bool FifoPattern::scopedAttemptApply(hlim::NodeGroup *nodeGroup) const
 {
 	// Only attempt to replace fifos
@@ -30,6 +30,8 @@ class FifoPattern : public TechnologyMappingPattern
 	public:
 		virtual ~FifoPattern() = default;
 
+		virtual std::string_view getRequiredGroupName() const override { return "scl_fifo"; }
+		virtual bool canApply(const hlim::NodeGroup *nodeGroup) const override;
 		virtual bool scopedAttemptApply(hlim::NodeGroup *nodeGroup) const override;
 	protected:
 };
@@ -35,6 +35,28 @@
 
 namespace gtry::scl::arch::xilinx {
 
+// Rough delay tables (in ns) of the mid speed grades. These are only meant for quick timing estimates, not for sign-off.
+static const hlim::TimingModel timing7Series = {
+	.routingDelay = 0.45f,
+	.lutDelay = 0.12f,
+	.carryChainDelayPerBit = 0.03f,
+	.equalityDelayPerBit = 0.05f,
+	.muxDelayPerInput = 0.1f,
+	.registerClockToOut = 0.35f,
+	.bramClockToOut = 2.0f,
+	.dspClockToOut = 3.4f,
+};
+
+static const hlim::TimingModel timingUltrascale = {
+	.routingDelay = 0.35f,
+	.lutDelay = 0.1f,
+	.carryChainDelayPerBit = 0.015f,
+	.equalityDelayPerBit = 0.04f,
+	.muxDelayPerInput = 0.08f,
+	.registerClockToOut = 0.1f,
+	.bramClockToOut = 1.3f,
+	.dspClockToOut = 2.6f,
+};
 
 
 struct Zynq7DeviceString {
@@ -195,6 +217,7 @@ void XilinxDevice::setupDevice(std::string device)
 
 	if (zynq7DevStr.parse(m_device)) {
 		m_family = "Zynq7";
+		m_timingCaps.setTimingModel(timing7Series);
 
 		m_embeddedMemoryList->add(std::make_unique<Lutram7Series>(*this));
 
@@ -206,6 +229,7 @@ void XilinxDevice::setupDevice(std::string device)
 			m_family = "Kintex Ultrascale";
 		else
 			m_family = "Virtex Ultrascale";
+		m_timingCaps.setTimingModel(timingUltrascale);
 
 		m_embeddedMemoryList->add(std::make_unique<LutramUltrascale>(*this));
 		m_embeddedMemoryList->add(std::make_unique<BlockramUltrascale>(*this));
@@ -18,6 +18,82 @@
 #include "gatery/pch.h"
 #include "crc.h"
 
+#include <gatery/simulation/BitVectorState.h>
+
+namespace gtry::scl
+{
+	namespace
+	{
+		/// One row of a GF(2) matrix, holding one bit per remainder and data input bit.
+		using GF2Row = std::vector<std::uint64_t>;
+
+		void xorInto(GF2Row &dst, const GF2Row &src)
+		{
+			for (size_t i = 0; i < dst.size(); i++)
+				dst[i] ^= src[i];
+		}
+
+		/**
+		 * @brief Runs the serial algorithm of crc() symbolically.
+		 * @details Returns for each bit of the resulting remainder the set of input bits (remainder bits first, then data bits) whose XOR it is.
+		 */
+		std::vector<GF2Row> crcTransitionMatrix(size_t remainderWidth, size_t dataWidth, const sim::DefaultBitVectorState &polynomial)
+		{
+			const size_t numInputs = remainderWidth + dataWidth;
+			const size_t stateWidth = std::max(remainderWidth, dataWidth);
+
+			std::vector<GF2Row> state(stateWidth, GF2Row((numInputs + 63) / 64, 0));
+			auto setInput = [](GF2Row &row, size_t input) { row[input / 64] ^= 1ull << (input % 64); };
+
+			for (size_t i = 0; i < remainderWidth; i++)
+				setInput(state[stateWidth - remainderWidth + i], i);
+			for (size_t i = 0; i < dataWidth; i++)
+				setInput(state[stateWidth - dataWidth + i], remainderWidth + i);
+
+			for (size_t i = 0; i < dataWidth; i++)
+			{
+				GF2Row sub = std::move(state.back());
+				for (size_t j = stateWidth - 1; j > 0; j--)
+					state[j] = std::move(state[j - 1]);
+				state[0] = GF2Row(sub.size(), 0);
+
+				for (size_t j = 0; j < polynomial.size(); j++)
+					if (polynomial.get(sim::DefaultConfig::VALUE, j))
+						xorInto(state[stateWidth - polynomial.size() + j], sub);
+			}
+
+			state.erase(state.begin(), state.begin() + (stateWidth - remainderWidth));
+			return state;
+		}
+
+		Bit xorTree(std::vector<Bit> terms)
+		{
+			if (terms.empty())
+				return '0';
+
+			while (terms.size() > 1)
+			{
+				std::vector<Bit> next;
+				next.reserve((terms.size() + 1) / 2);
+				for (size_t i = 0; i + 1 < terms.size(); i += 2)
+					next.push_back(terms[i] ^ terms[i + 1]);
+				if (terms.size() % 2)
+					next.push_back(terms.back());
+				terms = std::move(next);
+			}
+			return terms.front();
+		}
+
+		std::optional<sim::DefaultBitVectorState> staticPolynomial(const UInt &polynomial)
+		{
+			sim::DefaultBitVectorState value = evaluateStatically(polynomial);
+			if (!sim::allDefined(value))
+				return std::nullopt;
+			return value;
+		}
+	}
+}
+
 gtry::scl::CrcParams gtry::scl::CrcParams::init(CrcWellKnownParams standard)
 {
 	switch(standard)
@@ -109,6 +185,61 @@ gtry::UInt gtry::scl::crc(UInt remainder, UInt data, UInt polynomial)
 	return rem;
 }
 
+gtry::UInt gtry::scl::crcParallel(UInt remainder, UInt data, UInt polynomial)
+{
+	auto area = Area{ "crcParallel" }.enter();
+	HCL_NAMED(remainder);
+	HCL_NAMED(data);
+
+	auto polynomialValue = staticPolynomial(polynomial);
+	HCL_DESIGNCHECK_HINT(polynomialValue, "The polynomial of a parallel crc must be constant at elaboration time.");
+	HCL_DESIGNCHECK_HINT(polynomial.size() <= remainder.size(), "The polynomial of a crc can not be wider than the remainder.");
+
+	std::vector<GF2Row> matrix = crcTransitionMatrix(remainder.size(), data.size(), *polynomialValue);
+
+	UInt rem = ConstUInt(0, remainder.width());
+	for (size_t i = 0; i < rem.size(); i++)
+	{
+		std::vector<Bit> terms;
+		for (size_t j = 0; j < remainder.size(); j++)
+			if (matrix[i][j / 64] & (1ull << (j % 64)))
+				terms.push_back(remainder[j]);
+		for (size_t j = 0; j < data.size(); j++)
+		{
+			size_t input = remainder.size() + j;
+			if (matrix[i][input / 64] & (1ull << (input % 64)))
+				terms.push_back(data[j]);
+		}
+		rem[i] = xorTree(std::move(terms));
+	}
+	HCL_NAMED(rem);
+	return rem;
+}
+
+gtry::UInt gtry::scl::crcParallel(UInt remainder, UInt data, UInt polynomial, UInt byteEnable)
+{
+	HCL_DESIGNCHECK_HINT(data.size() % 8 == 0, "The data of a crc with byte enables must consist of whole bytes.");
+	HCL_DESIGNCHECK_HINT(byteEnable.size() == data.size() / 8, "A crc needs exactly one byte enable per byte of data.");
+
+	// Consume the enabled bytes in power of two sized chunks (binary decomposition of their count),
+	// which keeps the total size of the xor trees close to that of a single full beat.
+	size_t chunkBytes = 1;
+	while (chunkBytes * 2 <= byteEnable.size())
+		chunkBytes *= 2;
+
+	UInt rem = remainder;
+	for (; chunkBytes > 0; chunkBytes /= 2)
+	{
+		IF(byteEnable[byteEnable.size() - chunkBytes])
+		{
+			rem = crcParallel(rem, data.upper(BitWidth{ chunkBytes * 8 }), polynomial);
+			data <<= chunkBytes * 8;
+			byteEnable <<= chunkBytes;
+		}
+	}
+	return rem;
+}
+
 void gtry::scl::CrcState::init()
 {
 	remainder = params.initialRemainder;
@@ -119,7 +250,21 @@ void gtry::scl::CrcState::update(UInt data)
 	IF(params.reverseData)
 		data = swapEndian(data, 1_b);
 
-	remainder = crc(remainder, data, params.polynomial);
+	if (staticPolynomial(params.polynomial))
+		remainder = crcParallel(remainder, data, params.polynomial);
+	else
+		remainder = crc(remainder, data, params.polynomial);
+}
+
+void gtry::scl::CrcState::update(UInt data, UInt byteEnable)
+{
+	IF(params.reverseData)
+	{
+		data = swapEndian(data, 1_b);
+		byteEnable = swapEndian(byteEnable, 1_b);
+	}
+
+	remainder = crcParallel(remainder, data, params.polynomial, byteEnable);
 }
 
 gtry::UInt gtry::scl::CrcState::checksum() const
@@ -22,6 +22,20 @@ namespace gtry::scl
 {
 	UInt crc(UInt remainder, UInt data, UInt polynomial);
 
+	/**
+	 * @brief Computes the same function as crc(), but as one balanced XOR tree per remainder bit.
+	 * @details The polynomial must be constant at elaboration time. Its GF(2) state-transition matrix for the width of
+	 * data is computed while building the circuit, which avoids the chain of conditional XORs per data bit that crc() builds
+	 * and which is prohibitively large for wide data buses.
+	 */
+	UInt crcParallel(UInt remainder, UInt data, UInt polynomial);
+	/**
+	 * @brief Variant of crcParallel for the last beat of a packet in which only some bytes of data are valid.
+	 * @details As in crc(), data is consumed starting from the most significant bit. byteEnable holds one bit per byte of data
+	 * and must enable a contiguous run of bytes starting at the most significant one. If no byte is enabled, the remainder is returned unchanged.
+	 */
+	UInt crcParallel(UInt remainder, UInt data, UInt polynomial, UInt byteEnable);
+
 
 	enum class CrcWellKnownParams
 	{
@@ -51,7 +65,10 @@ namespace gtry::scl
 		UInt remainder;
 
 		void init();
+		/// Uses crcParallel if the polynomial is constant and falls back to crc() otherwise.
 		void update(UInt data);
+		/// Consumes only the bytes of data that are enabled (see crcParallel). Requires a constant polynomial.
+		void update(UInt data, UInt byteEnable);
 		UInt checksum() const;
 	};
 }
@@ -19,6 +19,8 @@
 #include <gatery/frontend.h>
 
 #include "../Counter.h"
+#include "../Fifo.h"
+#include "../stream/Packet.h"
 
 namespace gtry::scl
 {
@@ -31,8 +33,24 @@ namespace gtry::scl
 
 		void latency(size_t cycles);
 		void throughput(size_t cyclesPerHash);
+		/// Number of independent pipelines used by generate.
+		void lanes(size_t count);
+
+		/// Number of register stages placed by buildPipeline.
+		size_t pipelineStages() const;
 
 		void buildPipeline(THash& hash) const;
+
+		/**
+		 * @brief Hashes a stream of messages on lanes() pipelines built by buildPipeline.
+		 * @details Each packet is one message and each beat one padded block of THash::BLOCK_WIDTH bits.
+		 * Messages are distributed round robin over the lanes and their hashes are returned in message order.
+		 * A lane starts a new message every cycle. The next block of the same message waits until the chaining value of its
+		 * predecessor has left the pipeline, so with more lanes than pipeline stages long messages are hashed at one block per cycle.
+		 * THash must provide resume(chainingValue) to continue a message from the finalized value of its previous block.
+		 * @param laneQueueDepth Number of blocks buffered per lane, should be at least the length of the longest message.
+		 */
+		RvStream<UInt> generate(RvPacketStream<UInt>& blocks, size_t laneQueueDepth = 8) const;
 		void buildRoundProcessor(size_t startRound, THash& hash) const
 		{
 			const size_t numSections = std::max<size_t>(1, m_latency);
@@ -51,7 +69,7 @@ namespace gtry::scl
 					state.round(roundCounter.value() * roundsPerSection + (s * roundsPerSection + i));
 
 				if(m_latency > 0)
-					state = reg(state);
+					state = gtry::reg(state);
 
 				hash = state;
 			}
@@ -61,6 +79,7 @@ namespace gtry::scl
 	private:
 		size_t m_latency = 0;
 		size_t m_throughput = 1;
+		size_t m_lanes = 1;
 
 	};
 
@@ -83,6 +102,21 @@ namespace gtry::scl
 		m_throughput = cyclesPerHash;
 	}
 
+	template<typename THash>
+	inline void HashEngine<THash>::lanes(size_t count)
+	{
+		HCL_DESIGNCHECK_HINT(count > 0, "At least one lane is required.");
+		m_lanes = count;
+	}
+
+	template<typename THash>
+	inline size_t HashEngine<THash>::pipelineStages() const
+	{
+		if (!m_latency)
+			return 0;
+		return THash::NUM_ROUNDS / (THash::NUM_ROUNDS / m_latency);
+	}
+
 	template<typename THash>
 	inline void HashEngine<THash>::buildPipeline(THash& hash) const
 	{
@@ -96,7 +130,113 @@ namespace gtry::scl
 			hash.round(i);
 
 			if (i % regInterval == regInterval - 1)
-				hash = reg(hash);
+				hash = gtry::reg(hash);
+		}
+	}
+
+	template<typename THash>
+	inline RvStream<UInt> HashEngine<THash>::generate(RvPacketStream<UInt>& blocks, size_t laneQueueDepth) const
+	{
+		auto ent = Area{ "scl_HashEngine" }.enter();
+		HCL_DESIGNCHECK_HINT(blocks->width() == BitWidth{ THash::BLOCK_WIDTH }, "Each beat must hold exactly one message block.");
+		HCL_DESIGNCHECK_HINT(m_throughput == 1, "Only fully pipelined hash engines can be used on streams.");
+		HCL_NAMED(blocks);
+
+		const size_t stages = pipelineStages();
+		// every message that is in a pipeline or waiting in the result queue has reserved a result slot
+		const size_t resultDepth = stages + 4;
+
+		Counter inLane{ m_lanes };
+		IF(transfer(blocks) & eop(blocks))
+			inLane.inc();
+
+		Counter outLane{ m_lanes };
+		RvStream<UInt> out{ BitWidth{ THash::HASH_WIDTH } };
+		*out = ConstUInt(BitWidth{ THash::HASH_WIDTH });
+		valid(out) = '0';
+
+		ready(blocks) = '0';
+		std::list<Fifo<UInt>> results;
+		for (size_t l = 0; l < m_lanes; ++l)
+		{
+			auto laneEnt = Area{ "lane" + std::to_string(l) }.enter();
+
+			RvPacketStream<UInt> laneIn;
+			downstream(laneIn) = downstream(blocks);
+			IF(inLane.value() == l)
+				ready(blocks) = ready(laneIn);
+			ELSE
+				valid(laneIn) = '0';
+			RvPacketStream<UInt> queue = laneIn.fifo(laneQueueDepth);
+			HCL_NAMED(queue);
+
+			Fifo<UInt>& result = results.emplace_back(resultDepth, *out);
+
+			UInt reserved = BitWidth::last(resultDepth);
+			HCL_NAMED(reserved);
+			reserved = gtry::reg(reserved, 0);
+
+			// set while a block of an unfinished message is in the pipeline
+			Bit waitChain;
+			HCL_NAMED(waitChain);
+			waitChain = gtry::reg(waitChain, '0');
+
+			ready(queue) = (sop(queue) | !waitChain) & reserved != resultDepth;
+
+			// only the chaining value is fed back, constant parts of the state stay constant
+			UInt chainingValue = BitWidth{ THash::HASH_WIDTH };
+			HCL_NAMED(chainingValue);
+			chainingValue = gtry::reg(chainingValue);
+
+			THash state;
+			state.init();
+			IF(!sop(queue))
+				state.resume(chainingValue);
+			state.beginBlock(*queue);
+
+			Bit stageValid = transfer(queue);
+			Bit stageLast = eop(queue);
+			IF(stageValid & !stageLast)
+				waitChain = '1';
+			IF(stageValid & stageLast)
+				reserved += 1;
+
+			buildPipeline(state);
+			state.endBlock();
+			for (size_t i = 0; i < stages; ++i)
+			{
+				stageValid = gtry::reg(stageValid, '0');
+				stageLast = gtry::reg(stageLast);
+			}
+			HCL_NAMED(stageValid);
+			HCL_NAMED(stageLast);
+
+			IF(stageValid & !stageLast)
+			{
+				chainingValue = state.finalize();
+				waitChain = '0';
+			}
+			IF(stageValid & stageLast)
+				result.push(state.finalize());
+
+			// results are collected from the lanes in the order the messages were distributed
+			IF(outLane.value() == l)
+			{
+				*out = result.peek();
+				valid(out) = !result.empty();
+				IF(ready(out) & !result.empty())
+				{
+					result.pop();
+					reserved -= 1;
+					outLane.inc();
+				}
+			}
 		}
+
+		for (Fifo<UInt>& result : results)
+			result.generate();
+
+		HCL_NAMED(out);
+		return out;
 	}
 }
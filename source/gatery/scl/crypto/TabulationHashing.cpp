@@ -42,6 +42,15 @@ namespace gtry::scl
 		return *this;
 	}
 
+	TabulationHashing& TabulationHashing::readPortsPerTable(size_t ports)
+	{
+		HCL_ASSERT_HINT(m_tables.empty(), "invalid state");
+		HCL_DESIGNCHECK(ports > 0);
+
+		m_readPortsPerTable = ports;
+		return *this;
+	}
+
 	UInt gtry::scl::TabulationHashing::operator()(const UInt& data)
 	{
 		HCL_ASSERT_HINT(m_tables.empty(), "invalid state");
@@ -66,6 +75,76 @@ namespace gtry::scl
 		return hash;
 	}
 
+	std::vector<UInt> TabulationHashing::operator()(const std::vector<UInt>& data)
+	{
+		HCL_ASSERT_HINT(m_tables.empty(), "invalid state");
+		HCL_DESIGNCHECK(!data.empty());
+
+		GroupScope entity(GroupScope::GroupType::ENTITY);
+		entity.setName("TabulationHashingMultiPort");
+
+		const BitWidth dataWidth = data.front().width();
+		for (const UInt& d : data)
+			HCL_DESIGNCHECK_HINT(d.width() == dataWidth, "All keys must have the same width.");
+
+		const size_t numTables = (dataWidth.value + m_symbolWidth.value - 1) / m_symbolWidth.value;
+		const size_t numCopies = (data.size() + m_readPortsPerTable - 1) / m_readPortsPerTable;
+		m_tables.resize(numTables);
+		m_replicas.resize(numTables);
+		m_replicaWrites.resize(numTables);
+
+		std::vector<UInt> hash(data.size(), zext(0, m_hashWidth));
+		for (size_t t = 0; t < numTables; ++t)
+		{
+			const BitWidth addrWidth = std::min(m_symbolWidth, dataWidth - t * m_symbolWidth);
+			m_tables[t].setup(addrWidth.count(), m_hashWidth);
+			m_replicas[t].resize(numCopies - 1);
+			for (Memory<UInt>& replica : m_replicas[t])
+				replica.setup(addrWidth.count(), m_hashWidth);
+
+			for (size_t i = 0; i < data.size(); ++i)
+			{
+				const size_t copy = i / m_readPortsPerTable;
+				Memory<UInt>& table = copy == 0 ? m_tables[t] : m_replicas[t][copy - 1];
+				hash[i] ^= table[data[i](t * m_symbolWidth.value, addrWidth)];
+			}
+
+			// the update ports are created later and drive the write of all replicas through this
+			if (!m_replicas[t].empty())
+			{
+				TableWrite& write = m_replicaWrites[t];
+				write.address = addrWidth;
+				write.data = m_hashWidth;
+				for (Memory<UInt>& replica : m_replicas[t])
+					IF(write.valid)
+						replica[write.address] = write.data;
+
+				write.valid = '0';
+				write.address = dontCare(write.address);
+				write.data = dontCare(write.data);
+			}
+		}
+		HCL_NAMED(hash);
+		return hash;
+	}
+
+	void TabulationHashing::writeReplicas(size_t tableIdx, const UInt& address, const UInt& data)
+	{
+		if (m_replicas.empty() || m_replicas[tableIdx].empty())
+			return;
+
+		TableWrite& write = m_replicaWrites[tableIdx];
+		write.valid = '1';
+		write.address = address(0, write.address.width());
+		write.data = data(0, m_hashWidth);
+	}
+
+	void TabulationHashing::addCpuInterface(MemoryMap& mmap)
+	{
+		HCL_DESIGNCHECK_HINT(numTableCopies() <= 1, "The memory map stage writes the tables directly and can not update replicated tables. Use the update ports instead.");
+		mmap.stage(m_tables);
+	}
+
 	AvalonMM TabulationHashing::singleUpdatePort(bool readable)
 	{
 		HCL_ASSERT_HINT(!m_tables.empty(), "invalid state. call generator function first");
@@ -93,7 +172,10 @@ namespace gtry::scl
 				auto port = m_tables[t][avmm.address(symbolAddrRange)];
 
 				IF(*avmm.write)
+				{
 					port = *avmm.writeData;
+					writeReplicas(t, avmm.address(symbolAddrRange), *avmm.writeData);
+				}
 
 				if (avmm.readData)
 					*avmm.readData = port;
@@ -112,6 +194,13 @@ namespace gtry::scl
 
 		AvalonMM avmm;
 		avmm.connect(m_tables[tableIdx]);
+
+		if (!m_replicas.empty() && !m_replicas[tableIdx].empty())
+		{
+			HCL_DESIGNCHECK_HINT(m_hashWidth <= avmm.writeData->width(), "Replicated tables need the whole hash in one register of the update port.");
+			IF(*avmm.write)
+				writeReplicas(tableIdx, avmm.address, *avmm.writeData);
+		}
 		HCL_NAMED(avmm);
 		return avmm;
 	}
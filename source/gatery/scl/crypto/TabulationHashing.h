@@ -31,8 +31,16 @@ namespace gtry::scl
 
 		TabulationHashing& hashWidth(BitWidth width);
 		TabulationHashing& symbolWidth(BitWidth width);
+		/// Number of lookups one copy of a table serves per cycle. The default of one leaves the second port of a dual ported block ram to the update path.
+		TabulationHashing& readPortsPerTable(size_t ports);
 
 		virtual UInt operator () (const UInt& data);
+		/**
+		 * @brief Hashes all keys in the same cycle with one shared set of tables.
+		 * @details Tables are replicated only if there are more keys than readPortsPerTable. All copies of a table are written 
+		 *			by the same update path, so the update ports and the driver see a single set of tables.
+		 */
+		std::vector<UInt> operator () (const std::vector<UInt>& data);
 		size_t latency() const { return 1; }
 
 		AvalonMM singleUpdatePort(bool readable = false);
@@ -40,15 +48,29 @@ namespace gtry::scl
 
 		void updatePorts(AvalonNetworkSection& net);
 
-		void addCpuInterface(MemoryMap& mmap) { mmap.stage(m_tables); }
+		void addCpuInterface(MemoryMap& mmap);
 
 		size_t numTables() const { return m_tables.size(); }
+		size_t numTableCopies() const { return m_tables.empty() ? 0 : 1 + (m_replicas.empty() ? 0 : m_replicas.front().size()); }
 		BitWidth hashWidth() const { return m_hashWidth; }
 		BitWidth symbolWidth() const { return m_symbolWidth; }
 
 	private:
+		struct TableWrite
+		{
+			Bit valid;
+			UInt address;
+			UInt data;
+		};
+
+		void writeReplicas(size_t tableIdx, const UInt& address, const UInt& data);
+
 		BitWidth m_hashWidth;
 		BitWidth m_symbolWidth = 8_b;
+		size_t m_readPortsPerTable = 1;
 		std::vector<Memory<UInt>> m_tables;
+		/// Additional copies of each table for lookups beyond m_readPortsPerTable.
+		std::vector<std::vector<Memory<UInt>>> m_replicas;
+		std::vector<TableWrite> m_replicaWrites;
 	};
 }
@@ -52,6 +52,17 @@ namespace gtry::scl
 			hash = cat(a, b, c, d, e);
 		}
 
+		void resume(const TVec& chainingValue)
+		{
+			a = chainingValue(Selection::Symbol(4, 32_b));
+			b = chainingValue(Selection::Symbol(3, 32_b));
+			c = chainingValue(Selection::Symbol(2, 32_b));
+			d = chainingValue(Selection::Symbol(1, 32_b));
+			e = chainingValue(Selection::Symbol(0, 32_b));
+
+			hash = chainingValue;
+		}
+
 		void beginBlock(const TVec& _block)
 		{
 			for (size_t i = 0; i < w.size(); ++i)
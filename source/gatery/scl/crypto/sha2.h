@@ -70,6 +70,20 @@ namespace gtry::scl
 			hash = cat(a, b, c, d, e, f, g, h);
 		}
 
+		void resume(const UInt& chainingValue)
+		{
+			a = chainingValue(Selection::Symbol(7, 32_b));
+			b = chainingValue(Selection::Symbol(6, 32_b));
+			c = chainingValue(Selection::Symbol(5, 32_b));
+			d = chainingValue(Selection::Symbol(4, 32_b));
+			e = chainingValue(Selection::Symbol(3, 32_b));
+			f = chainingValue(Selection::Symbol(2, 32_b));
+			g = chainingValue(Selection::Symbol(1, 32_b));
+			h = chainingValue(Selection::Symbol(0, 32_b));
+
+			hash = chainingValue;
+		}
+
 		void beginBlock(const UInt& _block)
 		{
 			for (size_t i = 0; i < w.size(); ++i)
@@ -25,51 +25,326 @@ namespace gtry::scl
 {
 	template class TinyCuckoo<UInt, UInt>;
 
-	TinyCuckooOut tinyCuckoo(const TinyCuckooIn& in)
+	namespace
 	{
-		GroupScope entity(GroupScope::GroupType::ENTITY);
-		entity.setName("TinyCuckoo");
+		struct InsertEngineState
+		{
+			Bit active;
+			TinyCuckooItem item;
+			std::vector<TinyCuckooItem> stash;
+		};
+
+		/// Places the items of engine.request in the tables and returns the engine state after this cycle.
+		InsertEngineState insertEngine(const TinyCuckooIn& in, TinyCuckooInsertEngine& engine, std::vector<Memory<TinyCuckooItem>>& tables, TinyCuckooUpdate& write)
+		{
+			GroupScope entity(GroupScope::GroupType::ENTITY);
+			entity.setName("TinyCuckooInsertEngine");
+			HCL_DESIGNCHECK_HINT(engine.hash, "The insert engine needs a hash function to move evicted items.");
+
+			const BitWidth tableIdxWidth = BitWidth::count(in.numTables);
+			SymbolSelect hashPart{ in.tableWidth() };
+
+			auto makeItemReg = [&]() {
+				TinyCuckooItem item = constructFrom(in.update.item);
+				item.valid = gtry::reg(item.valid, '0');
+				item.key = gtry::reg(item.key);
+				item.value = gtry::reg(item.value);
+				return item;
+			};
+
+			// item that is being placed, it is either a request, an evicted item or a stashed item
+			InsertEngineState state;
+			state.active = gtry::reg(state.active, '0');
+			state.item = makeItemReg();
+			for (size_t i = 0; i < engine.stashSize; ++i)
+				state.stash.push_back(makeItemReg());
+			const std::vector<TinyCuckooItem> stash = state.stash;
 
-		TinyCuckooOut out;
-		out.found = '0';
-		out.hash = in.hash;
-		out.key = in.key;
-		out.userData = in.userData;
-		out.value = zext(0, in.valueWidth());
+			Bit decide;
+			decide = gtry::reg(decide, '0');
+			UInt kicks = BitWidth::last(engine.maxKicks);
+			kicks = gtry::reg(kicks, 0);
+			Bit hasOrigin;
+			hasOrigin = gtry::reg(hasOrigin, '0');
+			UInt originTable = tableIdxWidth;
+			originTable = gtry::reg(originTable, 0);
+			UInt victimTable = tableIdxWidth;
+			victimTable = gtry::reg(victimTable, 0);
+			HCL_NAMED(decide);
+			HCL_NAMED(kicks);
 
-		for(size_t l = 0; l < in.latency; l++)
-			out = reg(out);
+			const TinyCuckooItem item = state.item;
+			UInt itemHash = engine.hash(item.key);
+			HCL_NAMED(itemHash);
+			HCL_DESIGNCHECK_HINT(itemHash.width() == in.hash.width(), "The hash function of the insert engine must match the lookup hash.");
 
-		for (size_t i = 0; i < in.numTables; ++i)
+			// one cycle to read the candidate slots of the item, one cycle to decide where it goes
+			std::vector<TinyCuckooItem> slots;
+			std::vector<UInt> slotAddress;
+			for (size_t i = 0; i < in.numTables; ++i)
+			{
+				slotAddress.push_back(itemHash(hashPart[i]));
+				TinyCuckooItem slot = tables[i][slotAddress.back()];
+				slots.push_back(gtry::reg(slot));
+			}
+			HCL_NAMED(slots);
+
+			Bit keyHit = '0', freeSlot = '0';
+			UInt keyHitTable = ConstUInt(0, tableIdxWidth);
+			UInt freeTable = ConstUInt(0, tableIdxWidth);
+			for (size_t i = in.numTables; i-- > 0;)
+			{
+				IF(slots[i].valid & slots[i].key == item.key)
+				{
+					keyHit = '1';
+					keyHitTable = i;
+				}
+				IF(!slots[i].valid)
+				{
+					freeSlot = '1';
+					freeTable = i;
+				}
+			}
+
+			// never push an item straight back to the table it was evicted from
+			UInt evictTable = victimTable;
+			IF(hasOrigin & victimTable == originTable)
+			{
+				IF(victimTable == in.numTables - 1)
+					evictTable = 0;
+				ELSE
+					evictTable = victimTable + 1;
+			}
+			HCL_NAMED(evictTable);
+			TinyCuckooItem evicted = mux(evictTable, slots);
+
+			Bit stashHit = '0', stashFree = '0';
+			UInt stashHitIdx = ConstUInt(0, BitWidth::count(engine.stashSize));
+			UInt stashFreeIdx = ConstUInt(0, BitWidth::count(engine.stashSize));
+			for (size_t i = engine.stashSize; i-- > 0;)
+			{
+				IF(stash[i].valid & stash[i].key == item.key)
+				{
+					stashHit = '1';
+					stashHitIdx = i;
+				}
+				IF(!stash[i].valid)
+				{
+					stashFree = '1';
+					stashFreeIdx = i;
+				}
+			}
+
+			auto writeSlot = [&](const UInt& table) {
+				write.valid = '1';
+				write.tableIdx = zext(table, in.update.tableIdx.width());
+				write.itemIdx = mux(table, slotAddress);
+				write.item = item;
+			};
+			auto writeStash = [&](const UInt& idx) {
+				for (size_t i = 0; i < engine.stashSize; ++i)
+					IF(idx == i)
+						state.stash[i] = item;
+			};
+
+			// the tables may have changed under a pending decision, read them again
+			Bit tablesUpdated = in.update.valid | gtry::reg(in.update.valid, '0');
+
+			Bit done = '0';
+			engine.failed = '0';
+			IF(state.active & decide)
+			{
+				decide = '0';
+				IF(!tablesUpdated)
+				{
+					IF(victimTable == in.numTables - 1)
+						victimTable = 0;
+					ELSE
+						victimTable += 1;
+
+					IF(stashHit | keyHit | !item.valid | freeSlot)
+					{
+						// update in place, drop the removal of an unknown key or take a free slot
+						IF(stashHit)
+							writeStash(stashHitIdx);
+						ELSE
+						{
+							IF(keyHit)
+								writeSlot(keyHitTable);
+							ELSE
+							{
+								IF(item.valid)
+									writeSlot(freeTable);
+							}
+						}
+						done = '1';
+					}
+					ELSE
+					{
+						IF(kicks == engine.maxKicks)
+						{
+							IF(stashFree)
+								writeStash(stashFreeIdx);
+							ELSE
+								engine.failed = '1';
+							done = '1';
+						}
+						ELSE
+						{
+							writeSlot(evictTable);
+							state.item = evicted;
+							kicks += 1;
+							hasOrigin = '1';
+							originTable = evictTable;
+						}
+					}
+				}
+			}
+			ELSE
+			{
+				IF(state.active)
+					decide = '1';
+			}
+			HCL_NAMED(done);
+
+			engine.busy = state.active;
+			IF(done)
+				state.active = '0';
+
+			auto start = [&](const TinyCuckooItem& next) {
+				state.item = next;
+				state.active = '1';
+				decide = '0';
+				kicks = 0;
+				hasOrigin = '0';
+			};
+
+			ready(engine.request) = !state.active | done;
+			IF(transfer(engine.request))
+			{
+				start(*engine.request);
+			}
+			ELSE
+			{
+				// retry stashed items while there is nothing else to do
+				Bit idle = !engine.busy;
+				for (size_t i = 0; i < engine.stashSize; ++i)
+				{
+					IF(idle & stash[i].valid)
+					{
+						start(stash[i]);
+						state.stash[i].valid = '0';
+						idle = '0';
+					}
+				}
+			}
+
+			setName(engine.failed, "failed");
+			setName(engine.busy, "busy");
+			return state;
+		}
+
+		TinyCuckooOut tinyCuckooImpl(const TinyCuckooIn& in, TinyCuckooInsertEngine* engine)
 		{
 			GroupScope entity(GroupScope::GroupType::ENTITY);
-			entity.setName("TinyCuckooTable");
+			entity.setName("TinyCuckoo");
+
+			std::vector<Memory<TinyCuckooItem>> tables(in.numTables);
+			for (Memory<TinyCuckooItem>& mem : tables)
+			{
+				mem.setup(1ull << in.tableWidth().value, in.update.item);
+				//mem.setType(MemType::MEDIUM);
+				mem.initZero();
+			}
+
+			TinyCuckooUpdate write = in.update;
+			std::optional<InsertEngineState> engineState;
+			if (engine)
+			{
+				TinyCuckooUpdate engineWrite = dontCare(in.update);
+				engineWrite.valid = '0';
+				engineState = insertEngine(in, *engine, tables, engineWrite);
+				IF(!in.update.valid)
+					write = engineWrite;
+			}
+
+			TinyCuckooOut out;
+			out.found = '0';
+			out.hash = in.hash;
+			out.key = in.key;
+			out.userData = in.userData;
+			out.value = zext(0, in.valueWidth());
+
+			// items outside of the tables, with the in flight item being the most recent
+			Bit outsideHit = '0';
+			TinyCuckooItem outside = dontCare(in.update.item);
+			if (engineState)
+			{
+				for (const TinyCuckooItem& entry : engineState->stash)
+					IF(entry.valid & entry.key == in.key)
+					{
+						outsideHit = '1';
+						outside = entry;
+					}
+				IF(engineState->active & engineState->item.key == in.key)
+				{
+					outsideHit = '1';
+					outside = engineState->item;
+				}
+			}
+
+			for(size_t l = 0; l < in.latency; l++)
+			{
+				out = gtry::reg(out);
+				outsideHit = gtry::reg(outsideHit, '0');
+				outside = gtry::reg(outside);
+			}
 
-			Memory<TinyCuckooItem> mem(1ull << in.tableWidth().value, in.update.item);
-			//mem.setType(MemType::MEDIUM);
-			mem.initZero();
+			for (size_t i = 0; i < in.numTables; ++i)
+			{
+				GroupScope entity(GroupScope::GroupType::ENTITY);
+				entity.setName("TinyCuckooTable");
+
+				Memory<TinyCuckooItem>& mem = tables[i];
 
-			IF(in.update.valid & in.update.tableIdx == i)
-				mem[in.update.itemIdx] = in.update.item;
+				IF(write.valid & write.tableIdx == i)
+					mem[write.itemIdx] = write.item;
 
-			SymbolSelect hashPart{ BitWidth{ in.tableWidth().value } };
-			UInt lookupAddress = in.hash(hashPart[i]);
-			HCL_NAMED(lookupAddress);
+				SymbolSelect hashPart{ BitWidth{ in.tableWidth().value } };
+				UInt lookupAddress = in.hash(hashPart[i]);
+				HCL_NAMED(lookupAddress);
 
-			TinyCuckooItem lookupData = mem[lookupAddress];
-			for (size_t l = 0; l < in.latency; l++)
-				lookupData = reg(lookupData);
-			HCL_NAMED(lookupData);
+				TinyCuckooItem lookupData = mem[lookupAddress];
+				for (size_t l = 0; l < in.latency; l++)
+					lookupData = gtry::reg(lookupData);
+				HCL_NAMED(lookupData);
+
+				IF(lookupData.valid & (lookupData.key == out.key))
+				{
+					out.found = '1';
+					out.value = lookupData.value;
+				}
+			}
 
-			IF(lookupData.valid & (lookupData.key == out.key))
+			IF(outsideHit)
 			{
-				out.found = '1';
-				out.value = lookupData.value;
+				out.found = outside.valid;
+				out.value = outside.value;
 			}
+
+			HCL_NAMED(out);
+			return out;
 		}
+	}
 
-		HCL_NAMED(out);
-		return out;
+	TinyCuckooOut tinyCuckoo(const TinyCuckooIn& in)
+	{
+		return tinyCuckooImpl(in, nullptr);
+	}
+
+	TinyCuckooOut tinyCuckoo(const TinyCuckooIn& in, TinyCuckooInsertEngine& engine)
+	{
+		return tinyCuckooImpl(in, &engine);
 	}
 
 }
@@ -19,6 +19,7 @@
 #include <gatery/frontend.h>
 #include "../Avalon.h"
 #include "../memoryMap/MemoryMap.h"
+#include "../stream/Stream.h"
 
 namespace gtry::scl
 {
@@ -101,8 +102,31 @@ namespace gtry::scl
 		UInt userData;
 	};
 
+	struct TinyCuckooInsertEngine
+	{
+		/// Items to place in the tables. Items with valid cleared remove their key.
+		RvStream<TinyCuckooItem> request;
+		/// Computes TinyCuckooIn::hash for a key without latency, needed to move evicted items.
+		std::function<UInt(const UInt&)> hash;
+
+		size_t maxKicks = 16;
+		size_t stashSize = 2;
+
+		/// High for one cycle if an item fit neither into the tables nor into the stash. That item is lost.
+		Bit failed;
+		/// High while an item is placed. Stashed items are retried whenever the engine is idle.
+		Bit busy;
+	};
+
 	TinyCuckooOut tinyCuckoo(const TinyCuckooIn& in);
 
+	/**
+	 * @brief Lookup as above plus an insertion engine that performs cuckoo eviction chains in hardware.
+	 * @details Lookups continue at one per cycle. Items in the stash or in the middle of an eviction chain are found as well.
+	 * The update port of in keeps priority, the engine waits while it is used.
+	 */
+	TinyCuckooOut tinyCuckoo(const TinyCuckooIn& in, TinyCuckooInsertEngine& engine);
+
 	template<typename Tkey, typename Tval>
 	inline TinyCuckoo<Tkey, Tval>::TinyCuckoo(size_t capacity, const Tkey& key, const Tval& val, size_t numTables)
 	{
@@ -26,6 +26,43 @@
 
 using namespace gtry::scl::sdram;
 
+namespace
+{
+	// Grants the first input (maintenance) and read/write commands to open rows before row changes, lowest index first otherwise.
+	struct ArbiterPolicyRowHitFirst
+	{
+		bool enabled = false;
+
+		template<class TCont>
+		gtry::UInt operator () (const TCont& in)
+		{
+			using namespace gtry;
+			std::vector<Bit> valids;
+			std::vector<Bit> preferred;
+			for (const auto& s : in)
+			{
+				const Controller::CommandStream& cmd = s;
+				valids.push_back(valid(cmd));
+				preferred.push_back(valid(cmd) & (preferred.empty() | cmd->code == CommandCode::Read | cmd->code == CommandCode::Write));
+			}
+
+			auto idx = scl::priorityEncoder((UInt)cat(valids));
+			UInt selected = *idx;
+			IF(!valid(idx))
+				selected = 0;
+
+			if (enabled)
+			{
+				auto hit = scl::priorityEncoder((UInt)cat(preferred));
+				IF(valid(hit))
+					selected = *hit;
+			}
+			HCL_NAMED(selected);
+			return selected;
+		}
+	};
+}
+
 void Controller::generate(TileLinkUB& link)
 {
 	HCL_DESIGNCHECK_HINT(link.a->size.width() == BitWidth::last(m_burstLimit), "size width must match burst limit");
@@ -38,19 +75,20 @@ void Controller::generate(TileLinkUB& link)
 	UInt transferSize = transferLengthFromLogSize(transferLogSize, m_dataBusWidth.bits() / 8);
 	m_timer->generate(m_timing, m_cmdBus, transferSize, 1ull << m_burstLimit);
 
+	Bit bankRequestPending;
 	StreamArbiter<CommandStream> maintenanceArbiter;
 	{
 		auto initStream = initSequence();
 		maintenanceArbiter.attach(initStream);
 
-		auto refreshStream = refreshSequence(!valid(link.a));
+		auto refreshStream = refreshSequence(!valid(link.a) & !bankRequestPending);
 		maintenanceArbiter.attach(refreshStream);
 
 		maintenanceArbiter.generate();
 	}
 
 	StreamArbiter<DataOutStream> outArbiter;
-	StreamArbiter<CommandStream> cmdArbiter;
+	StreamArbiter<CommandStream, ArbiterPolicyRowHitFirst> cmdArbiter{ ArbiterPolicyRowHitFirst{ .enabled = m_bankQueueDepth != 0 } };
 	auto maintenanceStream = maintenanceArbiter.out().regDownstream();
 	cmdArbiter.attach(maintenanceStream);
 
@@ -59,6 +97,7 @@ void Controller::generate(TileLinkUB& link)
 	HCL_NAMED(m_bankState);
 
 	ready(link.a) = '0';
+	bankRequestPending = '0';
 	for(size_t i = 0; i < m_bankState.size(); ++i)
 	{
 		TileLinkChannelA aIn;
@@ -68,7 +107,8 @@ void Controller::generate(TileLinkUB& link)
 		ELSE
 			valid(aIn) = '0';
 
-		TileLinkChannelA aInReg = aIn.regReady();
+		TileLinkChannelA aInReg = m_bankQueueDepth == 0 ? aIn.regReady() : aIn.fifo(m_bankQueueDepth);
+		bankRequestPending |= valid(aInReg);
 		auto [cmd, data] = bankController(aInReg, m_bankState[i], ConstUInt(i, m_cmdBus.ba.width()));
 		cmd->bank = ConstUInt(i, m_cmdBus.ba.width()); // optional optimization
 
@@ -852,3 +892,9 @@ gtry::scl::sdram::Controller& gtry::scl::sdram::Controller::exportClockPin(bool
 	m_exportClockPin = enable;
 	return *this;
 }
+
+gtry::scl::sdram::Controller& gtry::scl::sdram::Controller::bankQueueDepth(size_t depth)
+{
+	m_bankQueueDepth = depth;
+	return *this;
+}
@@ -68,6 +68,13 @@ namespace gtry::scl::sdram
 		Controller& pinPrefix(std::string prefix);
 		Controller& driveStrength(DriveStrength value);
 		Controller& exportClockPin(bool enable = true);
+		/**
+		 * @brief Queues up to depth requests per bank instead of a single one.
+		 * @details Requests to other banks can then pass a bank that waits for ACTIVATE or PRECHARGE, so row changes overlap
+		 *			with data transfers of other banks. Read and write commands to open rows are scheduled before row changes.
+		 *			Requests to the same bank stay in order. Responses of different banks can return out of order.
+		 */
+		Controller& bankQueueDepth(size_t depth);
 
 		virtual void generate(TileLinkUB& link);
 
@@ -110,6 +117,7 @@ namespace gtry::scl::sdram
 		const bool m_useOutputRegister = true;
 		const bool m_useInputRegister = true;
 		bool m_exportClockPin = true;
+		size_t m_bankQueueDepth = 0;
 
 		Vector<BankState> m_bankState;
 		CommandBus m_cmdBus;
@@ -59,6 +59,16 @@ namespace gtry::scl
 	template<StreamSignal T> requires (T::template has<Empty>())
 	const UInt& empty(const T& s) { return s.template get<Empty>().empty; }
 
+	struct PacketEnds
+	{
+		BVec packetEnds; // one bit per byte, set on the last byte of each packet in this beat
+	};
+
+	template<StreamSignal T> requires (T::template has<PacketEnds>())
+	BVec& packetEnds(T& s) { return s.template get<PacketEnds>().packetEnds; }
+	template<StreamSignal T> requires (T::template has<PacketEnds>())
+	const BVec& packetEnds(const T& s) { return s.template get<PacketEnds>().packetEnds; }
+
 	template<Signal T, Signal... Meta>
 	using PacketStream = Stream<T, scl::Eop, Meta...>;
 
@@ -111,6 +121,7 @@ namespace gtry::scl
 BOOST_HANA_ADAPT_STRUCT(gtry::scl::Eop, eop);
 BOOST_HANA_ADAPT_STRUCT(gtry::scl::Sop, sop);
 BOOST_HANA_ADAPT_STRUCT(gtry::scl::Empty, empty);
+BOOST_HANA_ADAPT_STRUCT(gtry::scl::PacketEnds, packetEnds);
 
 namespace gtry::scl
 {
@@ -128,6 +128,149 @@ namespace gtry::scl
 		UInt m_selectedInput;
 	};
 
+	/**
+	 * @brief Arbiter for many inputs that splits the grant into a tree of registered levels and can grant several streams per cycle.
+	 * @details Inputs are arbitrated in groups of fanIn, each group's winner passes through a downstream register before it competes
+	 * on the next level, so the combinational grant path only spans fanIn inputs. The last level feeds numOutputs output streams,
+	 * each of which grants one of the remaining inputs per cycle. Packets stay on the output that granted their first beat.
+	 * Every arbitration uses its own instance of the selector policy. selectedInput() is not available for this arbiter.
+	 */
+	template<StreamSignal T, typename TSelector = ArbiterPolicyLowest>
+	requires (T::template has<Ready>() and T::template has<Valid>())
+	class PipelinedStreamArbiter : public StreamArbiter<T, TSelector>
+	{
+		using Base = StreamArbiter<T, TSelector>;
+	public:
+		PipelinedStreamArbiter(size_t numOutputs = 1, size_t fanIn = 4, TSelector&& selector = TSelector{}) :
+			Base(std::move(selector)), m_numOutputs(numOutputs), m_fanIn(fanIn)
+		{
+			HCL_DESIGNCHECK_HINT(numOutputs > 0, "The arbiter needs at least one output.");
+			HCL_DESIGNCHECK_HINT(fanIn >= 2, "The arbitration tree needs a fan in of at least two.");
+		}
+
+		using Base::out;
+		T& out(size_t idx)
+		{
+			HCL_DESIGNCHECK_HINT(idx < m_numOutputs, "Output index out of range.");
+			if (idx == 0)
+				return Base::out();
+			HCL_DESIGNCHECK_HINT(this->m_generated, "The additional outputs only exist after generate.");
+			return *std::next(m_additionalOut.begin(), idx - 1);
+		}
+
+		size_t numOutputs() const { return m_numOutputs; }
+
+		virtual void generate() override
+		{
+			auto area = Area{ "scl_PipelinedStreamArbiter" }.enter();
+			HCL_DESIGNCHECK_HINT(this->m_out, "No input stream attached and out template not provided.");
+			HCL_DESIGNCHECK_HINT(!this->m_generated, "Generate called twice.")
+			this->m_generated = true;
+
+			this->m_in.sort([](auto& a, auto& b) { return a.sortKey < b.sortKey; });
+
+			std::vector<T*> level;
+			for (auto& s : this->m_in)
+				level.push_back(&s.stream);
+
+			while (level.size() > std::max(m_fanIn, m_numOutputs))
+			{
+				std::vector<T*> nextLevel;
+				for (size_t first = 0; first < level.size(); first += m_fanIn)
+				{
+					auto& stage = m_stages.emplace_back(TSelector{ this->m_selector });
+					for (size_t i = first; i < std::min(first + m_fanIn, level.size()); i++)
+						stage.attach(*level[i]);
+					stage.generate();
+					nextLevel.push_back(&m_stageOut.emplace_back(stage.out().regDownstream()));
+				}
+				level = std::move(nextLevel);
+			}
+
+			for (size_t i = 1; i < m_numOutputs; i++)
+			{
+				T& o = m_additionalOut.emplace_back();
+				downstream(o) = constructFrom(copy(downstream(*this->m_out)));
+			}
+
+			grant(level);
+			HCL_NAMED(this->m_out);
+		}
+
+	protected:
+		void grant(const std::vector<T*>& inputs)
+		{
+			auto area = Area{ "grant" }.enter();
+
+			std::vector<T*> outputs = { &*this->m_out };
+			for (T& o : m_additionalOut)
+				outputs.push_back(&o);
+
+			for (T* in : inputs)
+				ready(*in) = '0';
+
+			// Outputs that hold on to an input (mid packet or stalled) keep it, the others pick from the inputs left over.
+			std::vector<UInt> selected(outputs.size());
+			std::vector<Bit> locked(outputs.size());
+			std::vector<Bit> claimed(inputs.size());
+			for (auto& c : claimed)
+				c = '0';
+
+			for (size_t k = 0; k < outputs.size(); k++)
+			{
+				selected[k] = BitWidth::count(inputs.size());
+				selected[k] = reg(selected[k], 0);
+				locked[k] = reg(locked[k], '0');
+				for (size_t i = 0; i < inputs.size(); i++)
+					IF(locked[k] & selected[k] == i)
+						claimed[i] = '1';
+			}
+
+			for (size_t k = 0; k < outputs.size(); k++)
+			{
+				T& out = *outputs[k];
+
+				std::vector<Bit> owns(inputs.size());
+				IF(!locked[k])
+				{
+					std::list<T> available;
+					for (size_t i = 0; i < inputs.size(); i++)
+					{
+						T& proxy = available.emplace_back();
+						valid(proxy) = valid(*inputs[i]) & !claimed[i];
+					}
+#ifdef __clang__
+					std::list<std::reference_wrapper<T>> availableRefs(available.begin(), available.end());
+					selected[k] = this->m_selector(availableRefs);
+#else
+					selected[k] = this->m_selector(available);
+#endif
+				}
+				for (size_t i = 0; i < inputs.size(); i++)
+				{
+					owns[i] = selected[k] == i & valid(*inputs[i]) & (locked[k] | !claimed[i]);
+					claimed[i] |= owns[i];
+				}
+				setName(selected[k], "selected" + std::to_string(k));
+
+				downstream(out) = dontCare(copy(downstream(out)));
+				valid(out) = '0';
+				for (size_t i = 0; i < inputs.size(); i++)
+					IF(owns[i])
+						out <<= *inputs[i];
+
+				IF(valid(out))
+					locked[k] = !(ready(out) & eop(out));
+			}
+		}
+
+		size_t m_numOutputs;
+		size_t m_fanIn;
+		std::list<T> m_additionalOut;
+		std::list<StreamArbiter<T, TSelector>> m_stages;
+		std::list<T> m_stageOut;
+	};
+
 	template<typename TSelector>
 	struct ArbiterPolicyReg : TSelector
 	{
@@ -18,6 +18,7 @@
 #pragma once
 #include "Packet.h"
 #include "../Counter.h"
+#include "../utils/BitCount.h"
 
 namespace gtry::scl
 {
@@ -30,6 +31,19 @@ namespace gtry::scl
 				and T::template has<Ready>())
 	T reduceWidth(T& source, BitWidth width, Bit reset = '0');
 
+	/**
+	 * @brief Converts a packet stream into a stream of the given width in which consecutive packets are packed back to back.
+	 * @details Unlike extendWidth, the tail of one packet and the head of the next one share an output beat, so short packets
+	 * do not leave bubbles. The valid bytes of each source beat must start at the lowest byte, which only the last beat of a packet may violate.
+	 * Packet boundaries are reported per byte through PacketEnds, at most maxPacketsPerBeat packets end in one output beat.
+	 * A partially filled beat is only sent early if it completes a packet and the source has no data.
+	 */
+	template<StreamSignal T>
+	requires (std::is_base_of_v<BaseBitVector, typename T::Payload>
+				and T::template has<Ready>() and T::template has<Valid>()
+				and T::template has<Eop>() and T::template has<ByteEnable>())
+	RvStream<BVec, ByteEnable, PacketEnds> gearbox(T& source, BitWidth width, size_t maxPacketsPerBeat = 2);
+
 	template<StreamSignal T> 
 	requires (T::template has<Ready>() and T::template has<Valid>())
 	T eraseBeat(T& source, UInt beatOffset, UInt beatCount);
@@ -139,6 +153,87 @@ namespace gtry::scl
 		return out;
 	}
 
+	template<StreamSignal T>
+	requires (std::is_base_of_v<BaseBitVector, typename T::Payload>
+				and T::template has<Ready>() and T::template has<Valid>()
+				and T::template has<Eop>() and T::template has<ByteEnable>())
+	RvStream<BVec, ByteEnable, PacketEnds> gearbox(T& source, BitWidth width, size_t maxPacketsPerBeat)
+	{
+		auto scope = Area{ "scl_gearbox" }.enter();
+
+		HCL_DESIGNCHECK_HINT(source->size() % 8 == 0 && width.bits() % 8 == 0, "The gearbox operates on whole bytes.");
+		HCL_DESIGNCHECK_HINT(byteEnable(source).size() * 8 == source->size(), "The gearbox needs one byte enable per byte of the source.");
+		HCL_DESIGNCHECK_HINT(maxPacketsPerBeat > 0, "At least one packet must be allowed to end per beat.");
+
+		const size_t srcBytes = source->size() / 8;
+		const size_t outBytes = width.bits() / 8;
+		// An output beat can always be completed while the bytes of one more source beat are held back.
+		const size_t bufferBytes = outBytes + srcBytes;
+
+		UInt buffer = BitWidth{ bufferBytes * 8 };
+		UInt enables = BitWidth{ bufferBytes };
+		UInt ends = BitWidth{ bufferBytes };
+		UInt fill = BitWidth::last(bufferBytes);
+		HCL_NAMED(fill);
+
+		RvStream<BVec, ByteEnable, PacketEnds> out;
+		*out = (BVec) buffer.lower(width);
+		byteEnable(out) = (BVec) enables.lower(BitWidth{ outBytes });
+		packetEnds(out) = (BVec) ends.lower(BitWidth{ outBytes });
+		Bit beatEndsPacket = ends.lower(BitWidth{ outBytes }) != 0;
+		valid(out) = fill >= outBytes | (beatEndsPacket & !valid(source));
+
+		IF(transfer(out))
+		{
+			buffer >>= (int) width.bits();
+			enables >>= (int) outBytes;
+			ends >>= (int) outBytes;
+			IF(fill > outBytes)
+				fill -= outBytes;
+			ELSE
+				fill = 0;
+		}
+
+		ready(source) = fill <= outBytes;
+
+		UInt srcEnables = (UInt) byteEnable(source);
+		UInt srcValidBytes = zext(bitcount(srcEnables), fill.width());
+		UInt srcEnds = ConstUInt(0, srcEnables.width());
+		IF(eop(source))
+			srcEnds = srcEnables & ~(srcEnables >> 1);
+		HCL_NAMED(srcValidBytes);
+
+		// Close the current beat early if the packet ending in this source beat would exceed the packet limit of the output beat.
+		Bit endsInBeat = eop(source) & fill + srcValidBytes <= outBytes;
+		Bit packetLimitReached = '0';
+		if (maxPacketsPerBeat < outBytes)
+			packetLimitReached = bitcount(ends.lower(BitWidth{ outBytes })) >= maxPacketsPerBeat;
+		UInt offset = fill;
+		IF(endsInBeat & packetLimitReached)
+			offset = outBytes;
+		HCL_NAMED(offset);
+
+		IF(transfer(source))
+		{
+			for (size_t o = 0; o <= outBytes; o++)
+				IF(offset == o)
+				{
+					buffer(o * 8, source->width()) = (UInt) *source;
+					enables(o, BitWidth{ srcBytes }) = srcEnables;
+					ends(o, BitWidth{ srcBytes }) = srcEnds;
+				}
+			fill = offset + srcValidBytes;
+		}
+
+		buffer = reg(buffer);
+		enables = reg(enables, 0);
+		ends = reg(ends, 0);
+		fill = reg(fill, 0);
+
+		HCL_NAMED(out);
+		return out;
+	}
+
 	template<StreamSignal T> 
 	requires (T::template has<Ready>() and T::template has<Valid>())
 	T eraseBeat(T& source, UInt beatOffset, UInt beatCount)
@@ -64,8 +64,7 @@ void GHDL::writeVhdlProjectScript(vhdl::VHDLExport &vhdlExport, std::string_view
 
 void GHDL::writeStandAloneProject(vhdl::VHDLExport& vhdlExport, std::string_view filename)
 {
-	std::fstream file((vhdlExport.getTestbenchDestination() / filename).string().c_str(), std::fstream::out);
-	file.exceptions(std::fstream::failbit | std::fstream::badbit);
+	std::stringstream file;
 
 	// "-frelaxed" is necessary for the vivado simulation models
 	std::string library;
@@ -85,6 +84,8 @@ void GHDL::writeStandAloneProject(vhdl::VHDLExport& vhdlExport, std::string_view
 		file << "ghdl -e --std=08 --ieee=synopsys -frelaxed " << library << e->getDependencySortedEntities().back() << std::endl;
 		file << "ghdl -r --std=08 -frelaxed -fsynopsys " << library << e->getDependencySortedEntities().back() << " --ieee-asserts=disable --vcd=" << e->getName() << "_signals.vcd --wave=" << e->getName() << "_signals.ghw" << std::endl;
 	}
+
+	vhdlExport.writeFile(vhdlExport.getTestbenchDestination() / filename, file.str());
 }
 
 }
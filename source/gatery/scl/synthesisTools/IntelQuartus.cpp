@@ -142,8 +142,7 @@ void IntelQuartus::resolveAttributes(const hlim::MemoryAttributes &attribs, hlim
 void IntelQuartus::writeClocksFile(vhdl::VHDLExport &vhdlExport, const hlim::Circuit &circuit, std::string_view filename)
 {
 	std::string fullPath = (vhdlExport.getDestination() / filename).string();
-	std::fstream file(fullPath.c_str(), std::fstream::out);
-	file.exceptions(std::fstream::failbit | std::fstream::badbit);
+	std::stringstream file;
 
 	writeClockSDC(*vhdlExport.getAST(), file);
 
@@ -240,20 +239,22 @@ void IntelQuartus::writeClocksFile(vhdl::VHDLExport &vhdlExport, const hlim::Cir
 
 	file << "derive_pll_clocks\n";
 	file << "derive_clock_uncertainty\n";
+
+	vhdlExport.writeFile(fullPath, file.str());
 }
 
 void IntelQuartus::writeConstraintFile(vhdl::VHDLExport &vhdlExport, const hlim::Circuit &circuit, std::string_view filename)
 {
-	std::fstream file((vhdlExport.getDestination() / filename).string().c_str(), std::fstream::out);
-	file.exceptions(std::fstream::failbit | std::fstream::badbit);
+	std::stringstream file;
 
 	// todo: write constraints
+
+	vhdlExport.writeFile(vhdlExport.getDestination() / filename, file.str());
 }
 
 void IntelQuartus::writeVhdlProjectScript(vhdl::VHDLExport &vhdlExport, std::string_view filename)
 {
-	std::fstream file((vhdlExport.getDestination() / filename).string().c_str(), std::fstream::out);
-	file.exceptions(std::fstream::failbit | std::fstream::badbit);
+	std::stringstream file;
 	file << R"(
 # This script is intended for adding the core to an existing project
 #	 1. Open the quartus tcl console (View->Utility Windows->Tcl Console) 
@@ -301,6 +302,8 @@ if {$currentDirectory != $projectDirectory} {
 	export_assignments
 }
 )";
+
+	vhdlExport.writeFile(vhdlExport.getDestination() / filename, file.str());
 }
 
 	void IntelQuartus::writeStandAloneProject(vhdl::VHDLExport& vhdlExport, std::string_view filename)
@@ -311,11 +314,10 @@ if {$currentDirectory != $projectDirectory} {
 			std::filesystem::path path = vhdlExport.getDestination() / filename;
 			path.replace_extension(".qpf");
 
-			std::fstream file(path.string().c_str(), std::fstream::out);
-
+			vhdlExport.writeFile(path, {});
 		}
 
-		std::fstream file((vhdlExport.getDestination() / filename).string().c_str(), std::fstream::out);
+		std::stringstream file;
 
 		file << R"(
 set_global_assignment -name PROJECT_OUTPUT_DIRECTORY output_files
@@ -350,6 +352,8 @@ set_global_assignment -name NUM_PARALLEL_PROCESSORS ALL
 			file << '\n';
 		}
 
+		vhdlExport.writeFile(vhdlExport.getDestination() / filename, file.str());
+
 		// TODO: remove and support modelsim as simulator
 		writeModelsimScripts(vhdlExport);
 	}
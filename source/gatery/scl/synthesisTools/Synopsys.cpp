@@ -93,10 +93,11 @@ void Synopsys::resolveAttributes(const hlim::MemoryAttributes &attribs, hlim::Re
 void Synopsys::writeClocksFile(vhdl::VHDLExport &vhdlExport, const hlim::Circuit &circuit, std::string_view filename)
 {
 	std::string fullPath = (vhdlExport.getDestination() / filename).string();
-	std::fstream file(fullPath.c_str(), std::fstream::out);
-	file.exceptions(std::fstream::failbit | std::fstream::badbit);
+	std::stringstream file;
 
 	writeClockSDC(*vhdlExport.getAST(), file);
+
+	vhdlExport.writeFile(fullPath, file.str());
 }
 
 
@@ -116,16 +116,16 @@ void XilinxVivado::resolveAttributes(const hlim::MemoryAttributes &attribs, hlim
 void XilinxVivado::writeClocksFile(vhdl::VHDLExport &vhdlExport, const hlim::Circuit &circuit, std::string_view filename)
 {
 	std::string fullPath = (vhdlExport.getDestination() / filename).string();
-	std::fstream file(fullPath.c_str(), std::fstream::out);
-	file.exceptions(std::fstream::failbit | std::fstream::badbit);
+	std::stringstream file;
 
 	writeClockXDC(*vhdlExport.getAST(), file);
+
+	vhdlExport.writeFile(fullPath, file.str());
 }
 
 void XilinxVivado::writeConstraintFile(vhdl::VHDLExport &vhdlExport, const hlim::Circuit &circuit, std::string_view filename)
 {
-	std::fstream file((vhdlExport.getDestination() / filename).string().c_str(), std::fstream::out);
-	file.exceptions(std::fstream::failbit | std::fstream::badbit);
+	std::stringstream file;
 
 	forEachPathAttribute(vhdlExport, circuit, [&](hlim::Node_PathAttributes* pa, std::string start, std::string end) {
 		const auto &startConType = hlim::getOutputConnectionType(pa->getDriver(0));
@@ -180,12 +180,12 @@ set cell_end_input_pin [get_pin -of_object $cell_end -filter {DIRECTION == IN &&
 		writeUserDefinedPathAttributes(file, attribs, "$cell_start", "$cell_end");
 	});
 
+	vhdlExport.writeFile(vhdlExport.getDestination() / filename, file.str());
 }
 
 void XilinxVivado::writeVhdlProjectScript(vhdl::VHDLExport &vhdlExport, std::string_view filename)
 {
-	std::fstream file((vhdlExport.getDestination() / filename).string().c_str(), std::fstream::out);
-	file.exceptions(std::fstream::failbit | std::fstream::badbit);
+	std::stringstream file;
 
 	std::vector<std::filesystem::path> files;
 
@@ -234,6 +234,8 @@ void XilinxVivado::writeVhdlProjectScript(vhdl::VHDLExport &vhdlExport, std::str
 # reset_run [get_runs * -filter IS_SYNTHESIS]
 # launch_runs [get_runs * -filter IS_IMPLEMENTATION]
 )";
+
+	vhdlExport.writeFile(vhdlExport.getDestination() / filename, file.str());
 }
 
 void XilinxVivado::writeStandAloneProject(vhdl::VHDLExport& vhdlExport, std::string_view filename)
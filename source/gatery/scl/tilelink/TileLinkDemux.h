@@ -31,7 +31,8 @@ namespace gtry::scl
 			BOOST_HANA_DEFINE_STRUCT(Sink,
 				(TLink, bus),
 				(uint64_t, address),
-				(size_t, addressBits)
+				(size_t, addressBits),
+				(size_t, requestQueueDepth)
 			);
 		};
 	public:
@@ -41,12 +42,23 @@ namespace gtry::scl
 
 		const TLink& source() const;
 
+		/**
+		 * @brief Puts a request queue of the given depth in front of every sink attached afterwards.
+		 * @details Requests for a sink that is busy then wait in its queue instead of blocking the requests for all other sinks.
+		 * Responses are already arbitrated per sink and thus return out of order. Each queued sink also tracks its outstanding
+		 * requests in a table keyed by source id, which the simulation checks for reused source ids and unexpected responses.
+		 */
+		void requestQueueDepth(size_t depth) { m_requestQueueDepth = depth; }
+
 		template<typename TArbiterPolicy = ArbiterPolicyLowest>
 		void generate();
+	protected:
+		void trackOutstandingRequests(Sink& sink);
 	private:
 		Area m_area = Area("scl_TileLinkDemux");
 		bool m_sourceAttached = false;
 		bool m_generated = false;
+		size_t m_requestQueueDepth = 0;
 		TLink m_source;
 		std::list<Sink> m_sink;
 	};
@@ -76,9 +88,18 @@ namespace gtry::scl
 
 		Sink& s = m_sink.emplace_back();
 		s.bus = constructFrom(sink);
-		sink <<= s.bus;
+		if (m_requestQueueDepth)
+		{
+			sink.a <<= s.bus.a.fifo(m_requestQueueDepth);
+			*s.bus.d <<= *sink.d;
+		}
+		else
+		{
+			sink <<= s.bus;
+		}
 		s.address = addressBase;
 		s.addressBits = sink.a->address.width().bits();
+		s.requestQueueDepth = m_requestQueueDepth;
 	}
 
 	template<TileLinkSignal TLink>
@@ -145,6 +166,10 @@ namespace gtry::scl
 		tileLinkErrorResponder(unmapped);
 		HCL_NAMED(unmapped);
 
+		for (Sink& s : m_sink)
+			if (s.requestQueueDepth)
+				trackOutstandingRequests(s);
+
 		// connect channel D
 		uint32_t sortKey = -1;
 		StreamArbiter<TileLinkChannelD, TArbiterPolicy> arbiter;
@@ -155,4 +180,31 @@ namespace gtry::scl
 		*m_source.d <<= arbiter.out();
 		arbiter.generate();
 	}
+
+	template<TileLinkSignal TLink>
+	inline void TileLinkDemux<TLink>::trackOutstandingRequests(Sink& sink)
+	{
+		auto scope = Area{ "outstandingRequests" }.enter();
+
+		const BitWidth idW = m_source.a->source.width();
+		HCL_DESIGNCHECK_HINT(idW <= 10_b, "The source ids are too wide to track outstanding requests per id.");
+
+		UInt outstanding = BitWidth{ 1ull << idW.bits() };
+		HCL_NAMED(outstanding);
+
+		const TileLinkChannelA& a = sink.bus.a;
+		const TileLinkChannelD& d = *sink.bus.d;
+		UInt requestId = a->source.lower(idW);
+		UInt responseId = d->source.lower(idW);
+
+		sim_assert(!(valid(a) & sop(a)) | (outstanding & decoder(requestId)) == 0) << "source id " << requestId << " reused while a request is outstanding";
+		sim_assert(!valid(d) | (outstanding & decoder(responseId)) != 0) << "response for source id " << responseId << " without outstanding request";
+
+		IF(transfer(d) & eop(d))
+			outstanding &= ~(UInt)decoder(responseId);
+		IF(transfer(a) & sop(a))
+			outstanding |= decoder(requestId);
+
+		outstanding = reg(outstanding, 0);
+	}
 }
@@ -40,6 +40,9 @@ namespace gtry::scl
 
 		virtual void attachSink(TLink&& sink, uint64_t addressBase) { attachSink(sink, addressBase); }
 		virtual void attachSink(TLink& sink, uint64_t addressBase);
+
+		/// Lets independent sinks proceed in parallel by queueing requests per sink, see TileLinkDemux::requestQueueDepth.
+		void requestQueueDepth(size_t depth) { m_demux.requestQueueDepth(depth); }
 		virtual void generate();
 	protected:
 		void enterSinkState();
@@ -17,6 +17,8 @@
 */
 #include "gatery/pch.h"
 #include "TileLinkStreamFetch.h"
+#include "../Fifo.h"
+#include "../Counter.h"
 
 namespace gtry::scl
 {
@@ -25,9 +27,32 @@ namespace gtry::scl
 		m_area.leave();
 	}
 
+	TileLinkStreamFetch& TileLinkStreamFetch::maxOutstanding(size_t count)
+	{
+		HCL_DESIGNCHECK_HINT(count > 0, "At least one request must be allowed in flight.");
+		m_maxOutstanding = count;
+		return *this;
+	}
+
+	TileLinkStreamFetch& TileLinkStreamFetch::maxBurstBeats(size_t beats)
+	{
+		HCL_DESIGNCHECK_HINT(utils::isPow2(beats), "The burst length must be a power of two.");
+		m_maxBurstBeats = beats;
+		return *this;
+	}
+
+	TileLinkUH TileLinkStreamFetch::generateBurst(RvStream<Command>& cmdIn, RvStream<BVec>& dataOut)
+	{
+		auto ent = m_area.enter();
+		return generateOutstanding<TileLinkUH>(cmdIn, dataOut, m_maxBurstBeats);
+	}
+
 	TileLinkUL TileLinkStreamFetch::generate(RvStream<Command>& cmdIn, RvStream<BVec>& dataOut)
 	{
 		auto ent = m_area.enter();
+		if (m_maxOutstanding > 1)
+			return generateOutstanding<TileLinkUL>(cmdIn, dataOut, 1);
+
 		HCL_NAMED(cmdIn);
 
 		auto link = tileLinkInit<TileLinkUL>(cmdIn->address.width(), dataOut->width());
@@ -79,5 +104,151 @@ namespace gtry::scl
 		HCL_NAMED(link);
 		return link;
 	}
-}
 
+	template<TileLinkSignal TLink>
+	TLink TileLinkStreamFetch::generateOutstanding(RvStream<Command>& cmdIn, RvStream<BVec>& dataOut, size_t burstBeats)
+	{
+		HCL_NAMED(cmdIn);
+		HCL_DESIGNCHECK_HINT(burstBeats == 1 || BitWidth::last(burstBeats) <= cmdIn->beats.width(), "The burst length exceeds the largest command.");
+
+		const size_t beatBytes = dataOut->width().bytes();
+		const size_t beatSizeLog2 = utils::Log2C(beatBytes);
+		const size_t burstSizeLog2 = beatSizeLog2 + utils::Log2C(burstBeats);
+
+		auto link = tileLinkInit<TLink>(cmdIn->address.width(), dataOut->width(), BitWidth::count(m_maxOutstanding), BitWidth::last(burstSizeLog2));
+		link.a->opcode = (size_t)TileLinkA::Get;
+		link.a->param = 0;
+		link.a->mask = link.a->mask.width().mask();
+		link.a->data = ConstBVec(link.a->data.width());
+
+		// Each source id owns a slot that stays busy until all beats of its request have been forwarded.
+		Counter issueSlot{ m_maxOutstanding };
+		Counter drainSlot{ m_maxOutstanding };
+		auto isSlot = [](const UInt& slot, size_t idx) -> Bit {
+			if (slot.width() == 0_b)
+				return '1';
+			return slot == idx;
+		};
+
+		UInt requestBeats = BitWidth::last(burstBeats);
+		std::vector<Bit> slotBusy(m_maxOutstanding);
+		std::vector<UInt> slotBeats(m_maxOutstanding);
+		for (size_t i = 0; i < m_maxOutstanding; ++i)
+		{
+			slotBusy[i] = reg(slotBusy[i], '0');
+			slotBeats[i] = requestBeats.width();
+			slotBeats[i] = reg(slotBeats[i]);
+		}
+		HCL_NAMED(slotBusy);
+		HCL_NAMED(slotBeats);
+
+		Bit issueSlotBusy = '0';
+		for (size_t i = 0; i < m_maxOutstanding; ++i)
+			IF(isSlot(issueSlot.value(), i))
+				issueSlotBusy = slotBusy[i];
+		HCL_NAMED(issueSlotBusy);
+
+		// in-order reassembly: responses may return in any order, one fifo per slot holds them until it is the oldest
+		std::list<Fifo<BVec>> reorder;
+		for (size_t i = 0; i < m_maxOutstanding; ++i)
+			reorder.emplace_back(std::max<size_t>(burstBeats, 2), (*link.d)->data);
+
+		ready(*link.d) = '1';
+		for (size_t i = 0; auto& fifo : reorder)
+			IF(valid(*link.d) & isSlot((*link.d)->source, i++))
+				fifo.push((*link.d)->data);
+
+		BVec drainData = ConstBVec(dataOut->width());
+		Bit drainEmpty = '1';
+		UInt drainBeats = ConstUInt(0, requestBeats.width());
+		for (size_t i = 0; auto& fifo : reorder)
+		{
+			IF(isSlot(drainSlot.value(), i))
+			{
+				drainData = fifo.peek();
+				drainEmpty = fifo.empty();
+				drainBeats = slotBeats[i];
+			}
+			i++;
+		}
+		HCL_NAMED(drainEmpty);
+		HCL_NAMED(drainBeats);
+
+		*dataOut = drainData;
+		valid(dataOut) = !drainEmpty;
+
+		UInt drainBeat = requestBeats.width();
+		HCL_NAMED(drainBeat);
+		drainBeat = reg(drainBeat, 0);
+		IF(transfer(dataOut))
+		{
+			for (size_t i = 0; auto& fifo : reorder)
+				IF(isSlot(drainSlot.value(), i++))
+					fifo.pop();
+
+			drainBeat += 1;
+			IF(drainBeat == drainBeats)
+			{
+				for (size_t i = 0; i < m_maxOutstanding; ++i)
+					IF(isSlot(drainSlot.value(), i))
+						slotBusy[i] = '0';
+				drainBeat = 0;
+				drainSlot.inc();
+			}
+		}
+		HCL_NAMED(dataOut);
+
+		UInt beatOffset = cmdIn->beats.width();
+		HCL_NAMED(beatOffset);
+		beatOffset = reg(beatOffset, 0);
+		link.a->address = cmdIn->address + zext(cat(beatOffset, ConstUInt(0, BitWidth::count(beatBytes))));
+		link.a->source = issueSlot.value();
+
+		requestBeats = 1;
+		link.a->size = beatSizeLog2;
+		if (burstBeats > 1)
+		{
+			UInt remaining = cmdIn->beats - beatOffset;
+			Bit aligned = link.a->address(beatSizeLog2, BitWidth{ burstSizeLog2 - beatSizeLog2 }) == 0;
+			IF(aligned & remaining >= burstBeats)
+			{
+				requestBeats = burstBeats;
+				link.a->size = burstSizeLog2;
+			}
+		}
+		HCL_NAMED(requestBeats);
+
+		valid(link.a) = valid(cmdIn) & !issueSlotBusy;
+		if (m_pauseFetch)
+		{
+			IF(*m_pauseFetch)
+				valid(link.a) = '0';
+			setName(*m_pauseFetch, "pauseFetch");
+		}
+
+		ready(cmdIn) = '0';
+		IF(transfer(link.a))
+		{
+			for (size_t i = 0; i < m_maxOutstanding; ++i)
+				IF(isSlot(issueSlot.value(), i))
+				{
+					slotBusy[i] = '1';
+					slotBeats[i] = requestBeats;
+				}
+			issueSlot.inc();
+
+			beatOffset += zext(requestBeats, beatOffset.width());
+			IF(beatOffset == cmdIn->beats)
+			{
+				ready(cmdIn) = '1';
+				beatOffset = 0;
+			}
+		}
+
+		for (auto& fifo : reorder)
+			fifo.generate();
+
+		HCL_NAMED(link);
+		return link;
+	}
+}
@@ -34,10 +34,22 @@ namespace gtry::scl
 		TileLinkStreamFetch();
 
 		TileLinkStreamFetch& pause(Bit condition) { m_pauseFetch = condition; return *this; }
+		/// Number of requests that may be in flight at the same time. Each one is issued with its own source id.
+		TileLinkStreamFetch& maxOutstanding(size_t count);
+		/// Largest burst (in beats, power of two) that generateBurst requests with a single Get.
+		TileLinkStreamFetch& maxBurstBeats(size_t beats);
+
 		virtual TileLinkUL generate(RvStream<Command>& cmdIn, RvStream<BVec>& dataOut);
+		/// Same as generate, but fetches aligned blocks of maxBurstBeats beats with a single burst request.
+		virtual TileLinkUH generateBurst(RvStream<Command>& cmdIn, RvStream<BVec>& dataOut);
 	private:
+		template<TileLinkSignal TLink>
+		TLink generateOutstanding(RvStream<Command>& cmdIn, RvStream<BVec>& dataOut, size_t burstBeats);
+
 		Area m_area = {"scl_TileLinkStreamFetch", true};
 		std::optional<Bit> m_pauseFetch;
+		size_t m_maxOutstanding = 1;
+		size_t m_maxBurstBeats = 1;
 	};
 
 
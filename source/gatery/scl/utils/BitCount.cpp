@@ -18,6 +18,8 @@
 #include "gatery/pch.h"
 #include "BitCount.h"
 
+#include "../algorithm/TreeReduce.h"
+
 #include <gatery/utils/BitManipulation.h>
 
 namespace gtry::scl {
@@ -63,5 +65,30 @@ namespace gtry::scl {
 #endif
 	}
 
- 
+	UInt bitcountTree(const UInt& vec, size_t numRegisterSteps)
+	{
+		GroupScope entity(GroupScope::GroupType::ENTITY);
+		entity
+			.setName("bitcountTree")
+			.setComment("Counts the number of high bits with an adder tree");
+
+		if (vec.empty())
+			return ConstUInt(0, 1_b);
+
+		std::vector<UInt> bits;
+		for (auto i : utils::Range(vec.size()))
+			bits.push_back(zext(vec[i], 1_b));
+
+		UInt sumOfOnes = treeReduce(bits, numRegisterSteps, [](const UInt& a, const UInt& b) {
+			const BitWidth sumWidth{ std::max(a.size(), b.size()) + 1 };
+			return zext(a, sumWidth) + zext(b, sumWidth);
+		});
+		HCL_NAMED(sumOfOnes);
+
+		// the tree widens each level, the count itself never needs more than this
+		const BitWidth resultWidth = BitWidth::last(vec.size());
+		if (sumOfOnes.width() > resultWidth)
+			return sumOfOnes.lower(resultWidth);
+		return zext(sumOfOnes, resultWidth);
+	}
 }
@@ -25,5 +25,8 @@
 namespace gtry::scl {
  
 UInt bitcount(UInt vec);
+
+/// Counts the high bits with a balanced adder tree of logarithmic depth. Registers are placed like in treeReduce.
+UInt bitcountTree(const UInt& vec, size_t numRegisterSteps = 0);
 	
 }
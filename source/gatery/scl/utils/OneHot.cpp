@@ -22,6 +22,37 @@
 
 using namespace gtry;
 
+namespace
+{
+	/// Places registers between the levels of a prefix network, counted from the output like treeReduce does.
+	class PrefixPipeline
+	{
+	public:
+		PrefixPipeline(size_t numLevels, size_t numRegisterSteps) :
+			m_numLevels(numLevels),
+			m_registersRemaining(numRegisterSteps),
+			m_registerInterval(numRegisterSteps > 0 ? (numLevels + numRegisterSteps - 1) / numRegisterSteps : 0)
+		{}
+
+		bool registerAfter(size_t level)
+		{
+			if (m_registersRemaining == 0 || m_registerInterval == 0)
+				return false;
+			if ((m_numLevels - 1 - level) % m_registerInterval != 0)
+				return false;
+			m_registersRemaining--;
+			return true;
+		}
+
+		size_t registersRemaining() const { return m_registersRemaining; }
+
+	private:
+		size_t m_numLevels;
+		size_t m_registersRemaining;
+		size_t m_registerInterval;
+	};
+}
+
 gtry::scl::OneHot gtry::scl::decoder(const UInt& in)
 {
 	OneHot ret = BitWidth{ 1ull << in.size() };
@@ -110,6 +141,122 @@ gtry::scl::VStream<UInt> gtry::scl::priorityEncoderTree(const UInt& in, bool reg
 	return out;
 }
 
+gtry::scl::VStream<UInt> gtry::scl::priorityEncoderPrefix(const UInt& in, size_t numRegisterSteps)
+{
+	if (in.empty())
+		return { ConstUInt(0_b), Valid{'0'} };
+
+	GroupScope entity(GroupScope::GroupType::ENTITY);
+	entity.setName("priorityEncoderPrefix");
+
+	const size_t numPrefixLevels = utils::Log2C(in.size());
+	PrefixPipeline pipeline{ numPrefixLevels + 1, numRegisterSteps };
+
+	UInt bits = in;
+	UInt prefix = in;
+	for (size_t level = 0; level < numPrefixLevels; ++level)
+	{
+		const size_t shift = 1ull << level;
+		prefix |= cat(prefix.lower(BitWidth{ in.size() - shift }), ConstUInt(0, BitWidth{ shift }));
+		setName(prefix, (boost::format("prefix_%i") % level).str());
+
+		if (pipeline.registerAfter(level))
+		{
+			bits = reg(bits);
+			prefix = reg(prefix);
+		}
+	}
+
+	// the lowest set bit is the only one without a set bit below it
+	UInt lowerSet = cat(prefix.lower(BitWidth{ in.size() - 1 }), '0');
+	OneHot first{ bits & ~lowerSet };
+	HCL_NAMED(first);
+
+	VStream<UInt> out{
+		zext(encoder(first), BitWidth::count(in.size())),
+		Valid{ prefix.msb() }
+	};
+	HCL_NAMED(out);
+
+	if (pipeline.registerAfter(numPrefixLevels))
+		out = reg(out);
+	for (size_t i = 0; i < pipeline.registersRemaining(); ++i)
+		out = reg(out);
+	return out;
+}
+
+std::vector<gtry::scl::VStream<gtry::UInt>> gtry::scl::findFirstSet(const UInt& in, size_t count, size_t numRegisterSteps)
+{
+	std::vector<VStream<UInt>> ret;
+	if (count == 0)
+		return ret;
+
+	if (in.empty())
+	{
+		ret.resize(count, { ConstUInt(0_b), Valid{'0'} });
+		return ret;
+	}
+
+	GroupScope entity(GroupScope::GroupType::ENTITY);
+	entity.setName("findFirstSet");
+
+	const size_t numPrefixLevels = utils::Log2C(in.size());
+	PrefixPipeline pipeline{ numPrefixLevels + 1, numRegisterSteps };
+
+	// number of set bits up to and including each position, saturating at count
+	const BitWidth countWidth = BitWidth::last(count);
+	auto saturatingAdd = [&](const UInt& a, const UInt& b) {
+		UInt sum = zext(a, +1_b) + zext(b, +1_b);
+		IF(sum > count)
+			sum = count;
+		return sum.lower(countWidth);
+	};
+
+	UInt bits = in;
+	std::vector<UInt> prefix(in.size());
+	for (size_t i = 0; i < in.size(); ++i)
+		prefix[i] = zext(in[i], countWidth);
+
+	for (size_t level = 0; level < numPrefixLevels; ++level)
+	{
+		const size_t shift = 1ull << level;
+		std::vector<UInt> next = prefix;
+		for (size_t i = shift; i < in.size(); ++i)
+			next[i] = saturatingAdd(prefix[i], prefix[i - shift]);
+		prefix = next;
+		setName(prefix, (boost::format("prefix_%i") % level).str());
+
+		if (pipeline.registerAfter(level))
+		{
+			bits = reg(bits);
+			for (UInt& p : prefix)
+				p = reg(p);
+		}
+	}
+
+	// a set bit is the n-th one if n bits are set up to and including it
+	for (size_t n = 0; n < count; ++n)
+	{
+		OneHot nth = BitWidth{ in.size() };
+		for (size_t i = 0; i < in.size(); ++i)
+			nth.at(i) = bits[i] & (prefix[i] == n + 1);
+
+		VStream<UInt>& out = ret.emplace_back(
+			zext(encoder(nth), BitWidth::count(in.size())),
+			Valid{ prefix.back() > n }
+		);
+		setName(out, (boost::format("out_%i") % n).str());
+	}
+
+	if (pipeline.registerAfter(numPrefixLevels))
+		for (VStream<UInt>& out : ret)
+			out = reg(out);
+	for (size_t i = 0; i < pipeline.registersRemaining(); ++i)
+		for (VStream<UInt>& out : ret)
+			out = reg(out);
+	return ret;
+}
+
 void gtry::scl::OneHot::setBit(const UInt& idx)
 {
 	// TODO: remove workaround false signal loop
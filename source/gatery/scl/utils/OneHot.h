@@ -46,4 +46,16 @@ namespace gtry::scl
 
 	VStream<UInt> priorityEncoder(const UInt& in);
 	VStream<UInt> priorityEncoderTree(const UInt& in, bool registerStep, size_t resultBitsPerStep = 2);
+
+	/**
+	 * @brief Priority encoder built on a Kogge-Stone prefix OR, logarithmic depth for wide inputs.
+	 * @param numRegisterSteps Pipeline registers, spread over the prefix levels like in treeReduce.
+	 */
+	VStream<UInt> priorityEncoderPrefix(const UInt& in, size_t numRegisterSteps = 0);
+
+	/**
+	 * @brief Indices of the lowest count set bits of in, lowest first. Uses a Kogge-Stone prefix count that saturates at count.
+	 * @param numRegisterSteps Pipeline registers, spread over the prefix levels like in treeReduce.
+	 */
+	std::vector<VStream<UInt>> findFirstSet(const UInt& in, size_t count, size_t numRegisterSteps = 0);
 }
@@ -28,34 +28,322 @@
 #include "../hlim/coreNodes/Node_Register.h"
 #include "../hlim/coreNodes/Node_Constant.h"
 #include "../hlim/coreNodes/Node_Pin.h"
+#include "../hlim/coreNodes/Node_Signal.h"
+#include "../hlim/coreNodes/Node_Arithmetic.h"
+#include "../hlim/coreNodes/Node_Compare.h"
+#include "../hlim/coreNodes/Node_Logic.h"
+#include "../hlim/coreNodes/Node_Multiplexer.h"
+#include "../hlim/coreNodes/Node_PriorityConditional.h"
+#include "../hlim/coreNodes/Node_Rewire.h"
+#include "../hlim/coreNodes/Node_Shift.h"
+#include "../hlim/supportNodes/Node_CDC.h"
+#include "../hlim/supportNodes/Node_Default.h"
+#include "../hlim/supportNodes/Node_ExportOverride.h"
+#include "../hlim/supportNodes/Node_RegHint.h"
+#include "../hlim/supportNodes/Node_RetimingBlocker.h"
 
 #include "../export/DotExport.h"
 
 namespace gtry::sim {
 
+namespace {
+
+/// Returns true for nodes whose simulation behavior does not depend on postprocessing, such that they can be evaluated directly in the live graph.
+bool canEvaluateInGraph(const hlim::BaseNode *node)
+{
+	return 
+		dynamic_cast<const hlim::Node_Constant*>(node) ||
+		dynamic_cast<const hlim::Node_Arithmetic*>(node) ||
+		dynamic_cast<const hlim::Node_Compare*>(node) ||
+		dynamic_cast<const hlim::Node_Logic*>(node) ||
+		dynamic_cast<const hlim::Node_Multiplexer*>(node) ||
+		dynamic_cast<const hlim::Node_PriorityConditional*>(node) ||
+		dynamic_cast<const hlim::Node_Rewire*>(node) ||
+		dynamic_cast<const hlim::Node_Shift*>(node) ||
+		dynamic_cast<const hlim::Node_Pin*>(node) ||
+		dynamic_cast<const hlim::Node_CDC*>(node) ||
+		dynamic_cast<const hlim::Node_RegHint*>(node) ||
+		dynamic_cast<const hlim::Node_RetimingBlocker*>(node);
+}
+
+DefaultBitVectorState undefinedState(size_t width)
+{
+	DefaultBitVectorState state;
+	state.resize(width);
+	state.clearRange(DefaultConfig::DEFINED, 0, width);
+	return state;
+}
+
+}
+
+ConstructionTimeSimulationContext::~ConstructionTimeSimulationContext()
+{
+	for (auto *node : m_observedNodes.anyOrder())
+		node->setObserver(nullptr);
+}
+
 void ConstructionTimeSimulationContext::overrideSignal(const SigHandle &handle, const DefaultBitVectorState &state)
 {
+	invalidate(handle.getOutput().node);
 	m_overrides[handle.getOutput()] = state;
 }
 
 void ConstructionTimeSimulationContext::overrideRegister(const SigHandle &handle, const DefaultBitVectorState &state)
 {
+	invalidate(handle.getOutput().node);
 	m_overrides[handle.getOutput()] = state;
 }
 
 void ConstructionTimeSimulationContext::getSignal(const SigHandle &handle, DefaultBitVectorState &state)
 {
+	auto it = m_valueCache.find(handle.getOutput());
+	if (it != m_valueCache.end()) {
+		state = it->second;
+		return;
+	}
+
+	if (evaluateInGraph(handle.getOutput())) {
+		state = m_valueCache.find(handle.getOutput())->second;
+		return;
+	}
+
+	evaluateBySubnetCopy(handle.getOutput(), state);
+	m_valueCache[handle.getOutput()] = state;
+}
+
+void ConstructionTimeSimulationContext::onInputRewired(hlim::BaseNode *node)
+{
+	invalidate(node);
+}
+
+void ConstructionTimeSimulationContext::onNodeDestroyed(hlim::BaseNode *node)
+{
+	invalidate(node);
+}
+
+void ConstructionTimeSimulationContext::observe(hlim::BaseNode *node)
+{
+	if (m_observedNodes.contains(node)) return;
+
+	HCL_ASSERT(node->getObserver() == nullptr);
+	node->setObserver(this);
+	m_observedNodes.insert(node);
+}
+
+void ConstructionTimeSimulationContext::invalidate(hlim::BaseNode *node)
+{
+	// Every memoized value that depends on the given node is (transitively) driven by it.
+	// Since all nodes in the cone of a memoized value are observed, it suffices to follow observed nodes.
+	// Nodes reached this way are no longer part of any memoized cone and are thus no longer observed.
+	// Only non-virtual NodeIO functions are used here since this is also called from node destructors.
+	std::vector<hlim::BaseNode*> openList;
+	openList.push_back(node);
+
+	while (!openList.empty()) {
+		auto *n = openList.back();
+		openList.pop_back();
+
+		if (!m_observedNodes.contains(n)) continue;
+		m_observedNodes.erase(n);
+		n->setObserver(nullptr);
+
+		for (auto i : utils::Range(n->getNumOutputPorts())) {
+			m_valueCache.erase({.node = n, .port = i});
+			for (auto c : n->getDirectlyDriven(i))
+				openList.push_back(c.node);
+		}
+	}
+}
+
+bool ConstructionTimeSimulationContext::evaluateInGraph(const hlim::NodePort &output)
+{
+	struct Step {
+		hlim::NodePort nodePort;
+		bool expanded;
+		/// For nodes that merely pass on a value (signals, registers' reset values, ...), the driver whose value is passed on.
+		std::optional<hlim::NodePort> forwardFrom;
+	};
+	std::vector<Step> stack;
+	stack.push_back({.nodePort = output, .expanded = false});
+
+	// Nodes that have been expanded, but not yet evaluated. These form the path from the output to the current step.
+	utils::UnstableSet<hlim::BaseNode*> pending;
+
+	auto dependsOn = [&](const hlim::NodePort &driver) {
+		if (driver.node == nullptr || m_valueCache.contains(driver)) return true;
+		if (pending.contains(driver.node)) return false; // combinatorial loop
+		stack.push_back({.nodePort = driver, .expanded = false});
+		return true;
+	};
+
+	auto forwards = [&](const hlim::NodePort &driver) {
+		stack.back().forwardFrom = driver;
+		return dependsOn(driver);
+	};
+
+	while (!stack.empty()) {
+		auto &step = stack.back();
+		auto nodePort = step.nodePort;
+		auto *node = nodePort.node;
+
+		if (m_valueCache.contains(nodePort)) {
+			stack.pop_back();
+			continue;
+		}
+
+		if (step.expanded) {
+			// All dependencies have been evaluated
+			auto forwardFrom = step.forwardFrom;
+			stack.pop_back();
+			pending.erase(node);
+
+			if (!forwardFrom)
+				evaluateNode(node);
+			else if (forwardFrom->node != nullptr)
+				m_valueCache[nodePort] = m_valueCache.find(*forwardFrom)->second;
+			else
+				m_valueCache[nodePort] = undefinedState(hlim::getOutputConnectionType(nodePort).width);
+			continue;
+		}
+
+		step.expanded = true;
+		observe(node);
+
+		// check overrides
+		{
+			auto it = m_overrides.find(nodePort);
+			if (it != m_overrides.end()) {
+				HCL_ASSERT(hlim::getOutputConnectionType(nodePort).width == it->second.size());
+				m_valueCache[nodePort] = it->second;
+				stack.pop_back();
+				continue;
+			}
+		}
+
+		pending.insert(node);
+
+		// try use reset value
+		if (auto *reg = dynamic_cast<hlim::Node_Register*>(node)) {
+			if (!forwards(reg->getDriver(hlim::Node_Register::Input::RESET_VALUE))) return false;
+			continue;
+		}
+
+		// use undefined for everything non-combinatorial (this includes clock and reset to signal conversions)
+		if (!node->isCombinatorial(nodePort.port)) {
+			m_valueCache[nodePort] = undefinedState(hlim::getOutputConnectionType(nodePort).width);
+			pending.erase(node);
+			stack.pop_back();
+			continue;
+		}
+
+		if (dynamic_cast<hlim::Node_Signal*>(node)) {
+			if (!forwards(node->getDriver(0))) return false;
+			continue;
+		}
+
+		if (dynamic_cast<hlim::Node_ExportOverride*>(node)) {
+			if (!forwards(node->getDriver(hlim::Node_ExportOverride::SIM_INPUT))) return false;
+			continue;
+		}
+
+		if (auto *defaultNode = dynamic_cast<hlim::Node_Default*>(node)) {
+			if (!forwards(node->getDriver(resolveDefaultInput(defaultNode)))) return false;
+			continue;
+		}
+
+		if (!canEvaluateInGraph(node)) {
+			// Only evaluate this one output the expensive way, everything downstream is still evaluated in the graph.
+			DefaultBitVectorState state;
+			evaluateBySubnetCopy(nodePort, state);
+			m_valueCache[nodePort] = std::move(state);
+			pending.erase(node);
+			stack.pop_back();
+			continue;
+		}
+
+		for (auto i : utils::Range(node->getNumInputPorts()))
+			if (!dependsOn(node->getDriver(i))) return false;
+	}
+
+	return true;
+}
+
+size_t ConstructionTimeSimulationContext::resolveDefaultInput(hlim::Node_Default *defaultNode)
+{
+	// Same as defaultValueResolution: The default value is only used if the signal loops back onto the default node.
+	// The result depends on the entire explored cone, so all of it must be observed.
+	utils::UnstableSet<hlim::BaseNode*> nodesAlreadyVisited;
+
+	for (auto handle : defaultNode->exploreInput(0)) {
+		if (nodesAlreadyVisited.contains(handle.node()) || !handle.node()->isCombinatorial(handle.port())) {
+			observe(handle.node());
+			handle.backtrack();
+		} else {
+			if (handle.node() == defaultNode)
+				return 1;
+			observe(handle.node());
+			nodesAlreadyVisited.insert(handle.node());
+		}
+	}
+	return 0;
+}
+
+void ConstructionTimeSimulationContext::evaluateNode(hlim::BaseNode *node)
+{
+	// Same layout as the simulator would use, but local to just this node
+	BitAllocator allocator;
+
+	std::vector<size_t> internalSizes = node->getInternalStateSizes();
+	std::vector<size_t> internalOffsets(internalSizes.size());
+	for (auto i : utils::Range(internalSizes.size()))
+		internalOffsets[i] = allocator.allocate(internalSizes[i]);
+
+	std::vector<size_t> inputOffsets(node->getNumInputPorts(), ~0ull);
+	for (auto i : utils::Range(node->getNumInputPorts())) {
+		auto driver = node->getDriver(i);
+		if (driver.node != nullptr)
+			inputOffsets[i] = allocator.allocate(hlim::getOutputConnectionType(driver).width);
+	}
+
+	std::vector<size_t> outputOffsets(node->getNumOutputPorts());
+	for (auto i : utils::Range(node->getNumOutputPorts()))
+		outputOffsets[i] = allocator.allocate(node->getOutputConnectionType(i).width);
+
+	DefaultBitVectorState state;
+	state.resize(allocator.getTotalSize());
+	state.clearRange(DefaultConfig::VALUE, 0, state.size());
+	state.clearRange(DefaultConfig::DEFINED, 0, state.size());
+
+	for (auto i : utils::Range(node->getNumInputPorts())) {
+		auto driver = node->getDriver(i);
+		if (driver.node != nullptr)
+			state.insert(m_valueCache.find(driver)->second, inputOffsets[i]);
+	}
+
+	SimulatorCallbacks ignoreCallbacks;
+	node->simulatePowerOn(ignoreCallbacks, state, internalOffsets.data(), outputOffsets.data());
+	node->simulateEvaluate(ignoreCallbacks, state, internalOffsets.data(), inputOffsets.data(), outputOffsets.data());
+
+	for (auto i : utils::Range(node->getNumOutputPorts()))
+		if (node->isCombinatorial(i))
+			m_valueCache[{.node = node, .port = i}] = state.extract(outputOffsets[i], node->getOutputConnectionType(i).width);
+}
+
+void ConstructionTimeSimulationContext::evaluateBySubnetCopy(const hlim::NodePort &output, DefaultBitVectorState &state)
+{
+	m_numSubnetCopyEvaluations++;
+
 	// Basic idea: Find and copy the combinatorial subnet. Then optimize and execute the subnet to find the value.
 	hlim::Circuit simCircuit;
 
 	utils::StableSet<hlim::NodePort> inputPorts;
-	utils::StableSet<hlim::NodePort> outputPorts = {handle.getOutput()};
+	utils::StableSet<hlim::NodePort> outputPorts = {output};
 
 	utils::UnstableMap<hlim::NodePort, hlim::NodePort> outputsTranslated;
 	utils::UnstableMap<hlim::NodePort, hlim::NodePort> outputsShorted;
 	utils::UnstableSet<hlim::NodePort> outputsHandled;
 	std::vector<hlim::NodePort> openList;
-	openList.push_back(handle.getOutput());
+	openList.push_back(output);
 
 	// Find all inputs/limits to combinatorial subnets, create constant nodes for those inputs
 	while (!openList.empty()) {
@@ -65,6 +353,9 @@ void ConstructionTimeSimulationContext::getSignal(const SigHandle &handle, Defau
 		if (outputsHandled.contains(nodePort)) continue;
 		outputsHandled.insert(nodePort);
 
+		// Everything in the cone invalidates the memoized result when rewired
+		observe(nodePort.node);
+
 		// check overrides
 		{
 			auto it = m_overrides.find(nodePort);
@@ -86,6 +377,12 @@ void ConstructionTimeSimulationContext::getSignal(const SigHandle &handle, Defau
 			auto type = hlim::getOutputConnectionType(nodePort);
 
 			auto reset = reg->getNonSignalDriver(hlim::Node_Register::Input::RESET_VALUE);
+			utils::UnstableSet<hlim::BaseNode*> resetSignals;
+			for (auto np = reg->getDriver(hlim::Node_Register::Input::RESET_VALUE); dynamic_cast<hlim::Node_Signal*>(np.node) != nullptr && !resetSignals.contains(np.node); np = np.node->getDriver(0)) {
+				resetSignals.insert(np.node);
+				observe(np.node);
+			}
+
 			if (reset.node != nullptr) {
 				outputPorts.insert(reset);
 				openList.push_back(reset);
@@ -170,13 +467,13 @@ void ConstructionTimeSimulationContext::getSignal(const SigHandle &handle, Defau
 	//visualize(simCircuit, "/tmp/circuit_03");
 
 	// Translate the output of interest
-	hlim::NodePort newOutput = handle.getOutput();
+	hlim::NodePort newOutput = output;
 	{
-		auto it = outputsTranslated.find(handle.getOutput());
+		auto it = outputsTranslated.find(output);
 		if (it != outputsTranslated.end())
 			newOutput = it->second;
 		else
-			newOutput.node = mapSrc2Dst.find(handle.getOutput().node)->second;
+			newOutput.node = mapSrc2Dst.find(output.node)->second;
 	}
 
 	// Force output's existence throughout optimization
@@ -19,15 +19,30 @@
 
 #include "SimulationContext.h"
 
+#include "../hlim/NodeIO.h"
+
 #include <gatery/utils/StableContainers.h>
 
 #include <map>
 
 
+namespace gtry::hlim {
+	class Node_Default;
+}
+
 namespace gtry::sim {
 
-class ConstructionTimeSimulationContext : public SimulationContext {
+/**
+ * @brief Simulation context for reading signal values during circuit construction (elaboration).
+ * @details Signal values are evaluated directly on the live graph and memoized per output port.
+ * The cached values are invalidated whenever a node in their combinatorial cone gets rewired or destroyed,
+ * or when an override within the cone changes. Cones with nodes that can not be evaluated before postprocessing
+ * fall back to copying, postprocessing, and simulating the subnet.
+ */
+class ConstructionTimeSimulationContext : public SimulationContext, public hlim::NodeIOObserver {
 	public:
+		virtual ~ConstructionTimeSimulationContext();
+
 		virtual void overrideSignal(const SigHandle &handle, const DefaultBitVectorState &state) override;
 		virtual void overrideRegister(const SigHandle &handle, const DefaultBitVectorState &state) override;
 		virtual void getSignal(const SigHandle &handle, DefaultBitVectorState &state) override;
@@ -43,8 +58,28 @@ class ConstructionTimeSimulationContext : public SimulationContext {
 		virtual void simulationProcessSuspending(std::coroutine_handle<> handle, WaitStable &waitStable) override;
 
 		virtual Simulator *getSimulator() override { return nullptr; }
+
+		/// Number of signal evaluations that had to resort to copying, postprocessing, and simulating a subnet.
+		size_t getNumSubnetCopyEvaluations() const { return m_numSubnetCopyEvaluations; }
+
+		virtual void onInputRewired(hlim::BaseNode *node) override;
+		virtual void onNodeDestroyed(hlim::BaseNode *node) override;
 	protected:
 		utils::UnstableMap<hlim::NodePort, DefaultBitVectorState> m_overrides;
+		/// Memoized values of all output ports that were evaluated so far.
+		utils::UnstableMap<hlim::NodePort, DefaultBitVectorState> m_valueCache;
+		/// All nodes that were visited while evaluating signals. This includes the cones of all memoized values,
+		/// but may also contain nodes of evaluations that were aborted (e.g. due to loops) until they are invalidated.
+		utils::UnstableSet<hlim::BaseNode*> m_observedNodes;
+		size_t m_numSubnetCopyEvaluations = 0;
+
+		void observe(hlim::BaseNode *node);
+		void invalidate(hlim::BaseNode *node);
+
+		bool evaluateInGraph(const hlim::NodePort &output);
+		void evaluateNode(hlim::BaseNode *node);
+		size_t resolveDefaultInput(hlim::Node_Default *defaultNode);
+		void evaluateBySubnetCopy(const hlim::NodePort &output, DefaultBitVectorState &state);
 };
 
 }
@@ -324,9 +324,7 @@ void Program::compileProgram(const hlim::Circuit &circuit, const hlim::Subnet &n
 
 				//loopSubnet.dilate(true, true);
 
-				DotExport exp("loop_only.dot");
-				exp(circuit, looping);
-				exp.runGraphViz("loop_only.svg");
+				visualize(circuit, "loop_only", looping);
 			}
 			//{
 			//	hlim::Subnet all;
@@ -109,7 +109,7 @@ namespace gtry::sim
 			m_nextIdentifier.resize(1);
 			m_nextIdentifier[0] = IDENT_BEG;
 		}
-		std::string getIdentifer()
+		VCDIdentifier getIdentifer()
 		{
 			std::string res = m_nextIdentifier;
 
@@ -129,7 +129,7 @@ namespace gtry::sim
 				}
 			}
 
-			return res;
+			return VCDIdentifier(res);
 		}
 	protected:
 		std::string m_nextIdentifier;
@@ -207,13 +207,13 @@ namespace gtry::sim
 			auto clocks_module = m_VCD.beginModule("clocks");
 
 			for(auto& clk : m_clocks) {
-				std::string id = identifierGenerator.getIdentifer();
+				VCDIdentifier id = identifierGenerator.getIdentifer();
 				m_clock2code[clk] = id;
 				m_VCD.declareWire(1, id, clk->getName());
 			}
 
 			for(auto& rst : m_resets) {
-				std::string id = identifierGenerator.getIdentifer();
+				VCDIdentifier id = identifierGenerator.getIdentifer();
 				m_rst2code[rst] = id;
 				m_VCD.declareWire(1, id, rst->getResetName());
 			}
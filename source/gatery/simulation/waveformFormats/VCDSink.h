@@ -53,9 +53,9 @@ class VCDSink : public WaveformRecorder
 
 		std::ofstream m_logFile;
 
-		std::vector<std::string> m_id2sigCode;
-		utils::StableMap<hlim::Clock*, std::string> m_clock2code;
-		utils::StableMap<hlim::Clock*, std::string> m_rst2code;
+		std::vector<VCDIdentifier> m_id2sigCode;
+		utils::StableMap<hlim::Clock*, VCDIdentifier> m_clock2code;
+		utils::StableMap<hlim::Clock*, VCDIdentifier> m_rst2code;
 		std::vector<hlim::Clock*> m_clocks;
 		std::vector<hlim::Clock*> m_resets;
 
@@ -63,9 +63,9 @@ class VCDSink : public WaveformRecorder
 		bool m_includeWarnings = true;
 		bool m_includeAsserts = true;
 
-		std::string m_debugMessageID;
-		std::string m_warningsID;
-		std::string m_assertsID;
+		VCDIdentifier m_debugMessageID;
+		VCDIdentifier m_warningsID;
+		VCDIdentifier m_assertsID;
 
 		virtual void initialize() override;
 		virtual void signalChanged(size_t id) override;
@@ -20,6 +20,42 @@
 #include "../../utils/Range.h"
 
 #include <chrono>
+#include <charconv>
+#include <cstring>
+
+namespace {
+	/// For every byte value, the eight characters '0'/'1' of its bits (msb first) and a mask selecting the bytes of all set bits.
+	struct BitCharTables {
+		std::array<uint64_t, 256> chars;
+		std::array<uint64_t, 256> setBitMask;
+		uint64_t allX;
+
+		BitCharTables() {
+			for (size_t byte = 0; byte < 256; byte++) {
+				std::array<char, 8> c, m;
+				for (size_t i = 0; i < 8; i++) {
+					bool bit = (byte >> (7 - i)) & 1;
+					c[i] = bit ? '1' : '0';
+					m[i] = bit ? (char) 0xFF : 0;
+				}
+				std::memcpy(&chars[byte], c.data(), 8);
+				std::memcpy(&setBitMask[byte], m.data(), 8);
+			}
+			std::array<char, 8> x;
+			x.fill('X');
+			std::memcpy(&allX, x.data(), 8);
+		}
+	};
+
+	const BitCharTables bitCharTables;
+}
+
+gtry::sim::VCDIdentifier::VCDIdentifier(std::string_view code)
+{
+	HCL_ASSERT(code.size() <= m_chars.size());
+	std::memcpy(m_chars.data(), code.data(), code.size());
+	m_length = (std::uint8_t) code.size();
+}
 
 gtry::sim::VCDWriter::VCDWriter(std::string filename) :
 	m_File(filename.c_str(), std::ofstream::binary)
@@ -27,6 +63,8 @@ gtry::sim::VCDWriter::VCDWriter(std::string filename) :
 	if(!m_File)
 		throw std::runtime_error("Could not open vcd file for writing! " + filename);
 
+	m_buffer.reserve(FLUSH_THRESHOLD + 4096);
+
 	auto now = std::chrono::system_clock::to_time_t(std::chrono::system_clock::now());
 
 	tm now_tb;
@@ -42,131 +80,159 @@ gtry::sim::VCDWriter::VCDWriter(std::string filename) :
 		<< "$timescale\n1ps\n$end\n";
 }
 
+gtry::sim::VCDWriter::~VCDWriter()
+{
+	try {
+		flush();
+	} catch (...) {
+	}
+}
+
+void gtry::sim::VCDWriter::flush()
+{
+	m_File.write(m_buffer.data(), m_buffer.size());
+	m_buffer.clear();
+}
+
 gtry::sim::VCDWriter::Scope gtry::sim::VCDWriter::beginModule(std::string_view name)
 {
 	assert(!name.empty());
 	assert(!m_EndDefinitions);
-	m_File << "$scope module " << name << " $end\n";
+	m_buffer.append("$scope module ").append(name).append(" $end\n");
 
 	return Scope([&]() {
 		assert(!m_EndDefinitions);
-		m_File << "$upscope $end\n";
+		m_buffer.append("$upscope $end\n");
 	});
 }
 
 void gtry::sim::VCDWriter::declareWire(size_t width, std::string_view code, std::string_view label)
 {
 	assert(!m_EndDefinitions);
-	m_File << "$var wire " << width << " " << code << " " << label << " $end\n";
+	m_buffer.append("$var wire ").append(std::to_string(width)).append(" ").append(code).append(" ").append(label).append(" $end\n");
+	flushIfFull();
 }
 
 void gtry::sim::VCDWriter::declareReal(std::string_view code, std::string_view label)
 {
 	assert(!m_EndDefinitions);
-	m_File << "$var real 0 " << code << " " << label << " $end\n";
+	m_buffer.append("$var real 0 ").append(code).append(" ").append(label).append(" $end\n");
 }
 
 gtry::sim::VCDWriter::Scope gtry::sim::VCDWriter::beginDumpVars()
 {
 	assert(!m_EndDefinitions);
-	m_File
-		<< "$enddefinitions $end\n"
-		<< "$dumpvars\n";
+	m_buffer.append("$enddefinitions $end\n$dumpvars\n");
 	m_EndDefinitions = true;
 
 	return Scope([&]() {
-		m_File << "$end\n";
+		m_buffer.append("$end\n");
 	});
 }
 
+void gtry::sim::VCDWriter::appendBits(uint64_t defined, uint64_t value, size_t size)
+{
+	// Leading bits that do not fill an entire byte
+	for (size_t bitIdx = size; bitIdx > size / 8 * 8; bitIdx--) {
+		bool def = (defined >> (bitIdx-1)) & 1;
+		bool val = (value >> (bitIdx-1)) & 1;
+		m_buffer.push_back(!def ? 'X' : (val ? '1' : '0'));
+	}
+
+	for (size_t byteIdx = size / 8; byteIdx > 0; byteIdx--) {
+		size_t shift = (byteIdx-1) * 8;
+		uint64_t chars = bitCharTables.chars[(value >> shift) & 0xFF];
+		uint64_t undefinedMask = bitCharTables.setBitMask[~(defined >> shift) & 0xFF];
+		chars = (chars & ~undefinedMask) | (bitCharTables.allX & undefinedMask);
+
+		char c[8];
+		std::memcpy(c, &chars, 8);
+		m_buffer.append(c, 8);
+	}
+}
+
+void gtry::sim::VCDWriter::appendCode(std::string_view code)
+{
+	m_buffer.append(code);
+	m_buffer.push_back('\n');
+	flushIfFull();
+}
+
 void gtry::sim::VCDWriter::writeState(std::string_view code, const DefaultBitVectorState& state, size_t offset, size_t size)
 {
 	assert(m_EndDefinitions);
 
-	m_File << 'b';
-	for(auto i : utils::Range(size)) {
-		auto bitIdx = size - 1 - i;
-		bool def = state.get(DefaultConfig::DEFINED, offset + bitIdx);
-		bool val = state.get(DefaultConfig::VALUE, offset + bitIdx);
-		if(!def)
-			m_File << 'X';
-		else if(val)
-			m_File << '1';
-		else
-			m_File << '0';
+	m_buffer.push_back('b');
+
+	// From msb to lsb in chunks of 64 bits, starting with the partial chunk.
+	size_t remaining = size;
+	while (remaining > 0) {
+		size_t chunkSize = remaining % 64 == 0 ? 64 : remaining % 64;
+		remaining -= chunkSize;
+		appendBits(
+			state.extract(DefaultConfig::DEFINED, offset + remaining, chunkSize),
+			state.extract(DefaultConfig::VALUE, offset + remaining, chunkSize),
+			chunkSize
+		);
 	}
-	m_File << ' ' << code << '\n';
+
+	m_buffer.push_back(' ');
+	appendCode(code);
 }
 
 void gtry::sim::VCDWriter::writeState(std::string_view code, size_t size, uint64_t defined, uint64_t valid)
 {
 	assert(m_EndDefinitions);
 
-	m_File << 'b';
-	for(auto i : utils::Range(size)) {
-		auto bitIdx = size - 1 - i;
-		bool def = (defined >> bitIdx) & 1;
-		bool val = (valid >> bitIdx) & 1;
-		if(!def)
-			m_File << 'X';
-		else if(val)
-			m_File << '1';
-		else
-			m_File << '0';
-	}
-	m_File << ' ' << code << '\n';
+	m_buffer.push_back('b');
+	appendBits(defined, valid, size);
+	m_buffer.push_back(' ');
+	appendCode(code);
 }
 
 void gtry::sim::VCDWriter::writeString(std::string_view code, size_t size, std::string_view text)
 {
 	assert(m_EndDefinitions);
-	
-	m_File << 'b';
+
+	m_buffer.push_back('b');
 	for(size_t i = 0; i < size / 8 && i < text.size(); ++i)
-	{
-		int c = text[i];
-		for(size_t i = 0; i < 8; ++i)
-		{
-			m_File << ((c & 0x80) ? '1' : '0');
-			c <<= 1;
-		}
-	}
-//	for(size_t i = text.size(); i < size; ++i)
-//		m_File << "00";
+		appendBits(~0ull, (unsigned char) text[i], 8);
 
-	m_File << ' ' << code << '\n';
+	m_buffer.push_back(' ');
+	appendCode(code);
 }
 
 void gtry::sim::VCDWriter::writeString(std::string_view code, std::string_view text)
 {
 	assert(m_EndDefinitions);
-	
-	m_File << 's';
+
+	m_buffer.push_back('s');
 	for (auto c : text)
 		if (c == ' ')
-			m_File << "\\x20";
+			m_buffer.append("\\x20");
 		else
-			m_File << c;
+			m_buffer.push_back(c);
 
-	m_File << ' ' << code << '\n';
+	m_buffer.push_back(' ');
+	appendCode(code);
 }
 
 void gtry::sim::VCDWriter::writeBitState(std::string_view code, bool defined, bool value)
 {
 	assert(m_EndDefinitions);
 
-	if(!defined)
-		m_File << 'X';
-	else if(value)
-		m_File << '1';
-	else
-		m_File << '0';
-
-	m_File << code << '\n';
+	m_buffer.push_back(!defined ? 'X' : (value ? '1' : '0'));
+	appendCode(code);
 }
 
 void gtry::sim::VCDWriter::writeTime(size_t time)
 {
 	assert(m_EndDefinitions);
-	m_File << '#' << time << '\n';
+
+	char digits[24];
+	auto [end, ec] = std::to_chars(digits, digits + sizeof(digits), time);
+	m_buffer.push_back('#');
+	m_buffer.append(digits, end);
+	m_buffer.push_back('\n');
+	flushIfFull();
 }
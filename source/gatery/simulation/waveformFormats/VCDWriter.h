@@ -19,11 +19,30 @@
 #include <string>
 #include <fstream>
 #include <functional>
+#include <array>
 
 #include "../BitVectorState.h"
 
 namespace gtry::sim
 {
+	/// Identifier code of a VCD signal, stored inline to avoid a heap allocation per signal.
+	class VCDIdentifier
+	{
+	public:
+		VCDIdentifier() = default;
+		VCDIdentifier(std::string_view code);
+
+		operator std::string_view() const { return { m_chars.data(), m_length }; }
+	protected:
+		std::array<char, 15> m_chars;
+		std::uint8_t m_length = 0;
+	};
+
+	/**
+	 * @brief Writes value change dump files.
+	 * @details All output is formatted into a large, reusable buffer that is written to the file in big chunks.
+	 * Bit vectors are converted eight bits at a time through lookup tables.
+	 */
 	class VCDWriter
 	{
 	public:
@@ -37,6 +56,7 @@ namespace gtry::sim
 		};
 
 		VCDWriter(std::string filename);
+		~VCDWriter();
 
 		explicit operator bool () const { return (bool)m_File; }
 
@@ -52,8 +72,20 @@ namespace gtry::sim
 		void writeBitState(std::string_view code, bool defined, bool value);
 		void writeTime(size_t time);
 
+		/// Writes all buffered output to the file.
+		void flush();
 	protected:
+		enum {
+			FLUSH_THRESHOLD = 1 << 20
+		};
+
 		std::ofstream m_File;
+		std::string m_buffer;
 		bool m_EndDefinitions = false;
+
+		/// Appends the lowest size bits, most significant bit first, as '0', '1', or 'X'.
+		void appendBits(uint64_t defined, uint64_t value, size_t size);
+		void appendCode(std::string_view code);
+		inline void flushIfFull() { if (m_buffer.size() >= FLUSH_THRESHOLD) flush(); }
 	};
 }
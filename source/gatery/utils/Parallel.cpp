@@ -0,0 +1,78 @@
+/*  This file is part of Gatery, a library for circuit design.
+	Copyright (C) 2021 Michael Offel, Andreas Ley
+
+	Gatery is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	Gatery is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#include "gatery/pch.h"
+#include "Parallel.h"
+
+#include <atomic>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace gtry::utils {
+
+size_t resolveNumThreads(size_t numThreads)
+{
+	if (numThreads == 0)
+		numThreads = std::max<size_t>(1, std::thread::hardware_concurrency());
+	return numThreads;
+}
+
+void parallelFor(size_t numJobs, const std::function<void(size_t)> &job, size_t numThreads)
+{
+	numThreads = std::min(resolveNumThreads(numThreads), numJobs);
+
+	if (numThreads <= 1) {
+		for (size_t i = 0; i < numJobs; i++)
+			job(i);
+		return;
+	}
+
+	std::atomic<size_t> nextJob = 0;
+	std::atomic<bool> failed = false;
+	std::exception_ptr firstException;
+	std::mutex exceptionMutex;
+
+	auto worker = [&] {
+		while (!failed) {
+			size_t i = nextJob++;
+			if (i >= numJobs) break;
+			try {
+				job(i);
+			} catch (...) {
+				std::lock_guard lock(exceptionMutex);
+				if (!firstException)
+					firstException = std::current_exception();
+				failed = true;
+			}
+		}
+	};
+
+	std::vector<std::thread> threads;
+	threads.reserve(numThreads-1);
+	for (size_t i = 0; i+1 < numThreads; i++)
+		threads.emplace_back(worker);
+	worker();
+	for (auto &t : threads)
+		t.join();
+
+	if (firstException)
+		std::rethrow_exception(firstException);
+}
+
+}
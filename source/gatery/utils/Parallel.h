@@ -0,0 +1,35 @@
+/*  This file is part of Gatery, a library for circuit design.
+	Copyright (C) 2021 Michael Offel, Andreas Ley
+
+	Gatery is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	Gatery is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <cstddef>
+#include <functional>
+
+namespace gtry::utils {
+
+/**
+ * @brief Runs job(0) ... job(numJobs-1) on up to numThreads worker threads and waits for all of them.
+ * @details A numThreads of zero uses one thread per hardware thread. With a single thread (or job), everything runs
+ * on the calling thread. If jobs throw, the remaining jobs are skipped and the first exception is rethrown.
+ */
+void parallelFor(size_t numJobs, const std::function<void(size_t)> &job, size_t numThreads = 0);
+
+/// Resolves a thread count of zero to the number of hardware threads.
+size_t resolveNumThreads(size_t numThreads);
+
+}
@@ -0,0 +1,72 @@
+/*  This file is part of Gatery, a library for circuit design.
+	Copyright (C) 2021 Michael Offel, Andreas Ley
+
+	Gatery is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	Gatery is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#include "gatery/pch.h"
+#include "SlabAllocator.h"
+#include "Exceptions.h"
+#include "Preprocessor.h"
+
+#include <new>
+#include <algorithm>
+
+namespace gtry::utils {
+
+SlabAllocator::SlabAllocator(size_t objectSize, size_t objectAlignment, size_t objectsPerSlab) : m_objectsPerSlab(objectsPerSlab)
+{
+	HCL_ASSERT(objectsPerSlab > 0);
+	// Every slot must be able to hold a free list entry while unused.
+	m_slotAlignment = std::max(objectAlignment, alignof(FreeSlot));
+	m_slotSize = std::max(objectSize, sizeof(FreeSlot));
+	m_slotSize = (m_slotSize + m_slotAlignment-1) / m_slotAlignment * m_slotAlignment;
+}
+
+SlabAllocator::~SlabAllocator()
+{
+	HCL_ASSERT_HINT(m_numAllocated == 0, "Not all objects have been returned to the slab allocator before its destruction!");
+	for (auto *slab : m_slabs)
+		::operator delete(slab, std::align_val_t(m_slotAlignment));
+}
+
+void *SlabAllocator::allocate()
+{
+	if (m_firstFree == nullptr) {
+		auto *slab = static_cast<std::byte*>(::operator new(m_slotSize * m_objectsPerSlab, std::align_val_t(m_slotAlignment)));
+		m_slabs.push_back(slab);
+		// Chain in reverse such that consecutive allocations are consecutive in memory
+		for (size_t i = m_objectsPerSlab; i > 0; i--) {
+			auto *slot = new (slab + (i-1) * m_slotSize) FreeSlot;
+			slot->next = m_firstFree;
+			m_firstFree = slot;
+		}
+	}
+
+	FreeSlot *slot = m_firstFree;
+	m_firstFree = slot->next;
+	m_numAllocated++;
+	return slot;
+}
+
+void SlabAllocator::deallocate(void *ptr)
+{
+	HCL_ASSERT(m_numAllocated > 0);
+	auto *slot = new (ptr) FreeSlot;
+	slot->next = m_firstFree;
+	m_firstFree = slot;
+	m_numAllocated--;
+}
+
+}
@@ -0,0 +1,58 @@
+/*  This file is part of Gatery, a library for circuit design.
+	Copyright (C) 2021 Michael Offel, Andreas Ley
+
+	Gatery is free software; you can redistribute it and/or
+	modify it under the terms of the GNU Lesser General Public
+	License as published by the Free Software Foundation; either
+	version 3 of the License, or (at your option) any later version.
+
+	Gatery is distributed in the hope that it will be useful,
+	but WITHOUT ANY WARRANTY; without even the implied warranty of
+	MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the GNU
+	Lesser General Public License for more details.
+
+	You should have received a copy of the GNU Lesser General Public
+	License along with this library; if not, write to the Free Software
+	Foundation, Inc., 51 Franklin Street, Fifth Floor, Boston, MA  02110-1301  USA
+*/
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+namespace gtry::utils {
+
+/**
+ * @brief Allocates memory for objects of one fixed size from large, contiguous slabs.
+ * @details Freed slots are kept in a free list and reused by subsequent allocations.
+ * Slabs are only released when the allocator itself is destroyed, so all objects must be destroyed before that.
+ * Not thread safe, the owner is responsible for synchronization if needed.
+ */
+class SlabAllocator
+{
+	public:
+		SlabAllocator(size_t objectSize, size_t objectAlignment, size_t objectsPerSlab = 256);
+		~SlabAllocator();
+		SlabAllocator(const SlabAllocator &) = delete;
+		void operator=(const SlabAllocator &) = delete;
+
+		void *allocate();
+		void deallocate(void *ptr);
+
+		inline size_t getNumSlabs() const { return m_slabs.size(); }
+		inline size_t getNumAllocated() const { return m_numAllocated; }
+		inline size_t getSlotSize() const { return m_slotSize; }
+	protected:
+		struct FreeSlot {
+			FreeSlot *next;
+		};
+
+		size_t m_slotSize;
+		size_t m_slotAlignment;
+		size_t m_objectsPerSlab;
+		size_t m_numAllocated = 0;
+		FreeSlot *m_firstFree = nullptr;
+		std::vector<std::byte*> m_slabs;
+};
+
+}
@@ -180,3 +180,36 @@ BOOST_FIXTURE_TEST_CASE(intentionalCDCDetection, gtry::BoostUnitTestSimulationFi
 	BOOST_TEST(detections == 0);
 }
 
+
+BOOST_FIXTURE_TEST_CASE(unintentionalCDCDetectionDeepChain, gtry::BoostUnitTestSimulationFixture)
+{
+	using namespace gtry;
+
+	Clock clock1({ .absoluteFrequency = 10'000 });
+	Clock clock2({ .absoluteFrequency = 10'000 });
+
+	UInt a = 8_b;
+	UInt b = 8_b;
+	UInt c = 8_b;
+
+	{
+		ClockScope clockScope(clock1);
+		a = reg(b, 0);
+	}
+
+	// A long combinatorial chain must neither be resolved recursively nor hide the crossings at its end.
+	UInt chain = a;
+	for ([[maybe_unused]] auto i : gtry::utils::Range(10'000))
+		chain = chain + 1;
+
+	{
+		ClockScope clockScope(clock2);
+		b = reg(chain, 0);
+		c = reg(chain ^ a, 0);
+	}
+
+	auto detections = gtry::hlim::findUnguardedCDCCrossings(design.getCircuit(), gtry::hlim::ConstSubnet::all(design.getCircuit()));
+	BOOST_TEST(detections.size() == 3);
+	for (auto node : detections)
+		BOOST_TEST(dynamic_cast<const gtry::hlim::Node_Register*>(node) != nullptr);
+}
@@ -277,4 +277,47 @@ BOOST_FIXTURE_TEST_CASE(testMemoryInVCD, VCDTestFixture<BoostUnitTestSimulationF
 
 
 
+BOOST_AUTO_TEST_CASE(writerFormatsStatesBitByBit)
+{
+	using namespace gtry;
+
+	sim::DefaultBitVectorState state;
+	state.resize(100);
+	for (size_t i = 0; i < 100; i++) {
+		state.set(sim::DefaultConfig::DEFINED, i, i % 7 != 3);
+		state.set(sim::DefaultConfig::VALUE, i, i % 3 == 0);
+	}
+
+	std::string expectedWide = "b";
+	for (size_t i = 5 + 90; i > 5; i--)
+		expectedWide += state.get(sim::DefaultConfig::DEFINED, i-1) ? (state.get(sim::DefaultConfig::VALUE, i-1) ? '1' : '0') : 'X';
+	expectedWide += " !\n";
+
+	{
+		sim::VCDWriter vcd("vcdWriterTest.vcd");
+		{
+			auto module = vcd.beginModule("top");
+			vcd.declareWire(90, "!", "wide");
+			vcd.declareWire(11, "\"", "narrow");
+			vcd.declareWire(1, "#", "bit");
+		}
+		{
+			auto dumpVars = vcd.beginDumpVars();
+			vcd.writeState("!", state, 5, 90);
+			vcd.writeState("\"", 11, 0b10111111011, 0b00000000101);
+			vcd.writeBitState("#", false, true);
+		}
+		vcd.writeTime(1234);
+		vcd.writeBitState("#", true, true);
+	}
+
+	std::ifstream file("vcdWriterTest.vcd", std::ifstream::binary);
+	std::string content(std::istreambuf_iterator<char>(file), {});
+
+	BOOST_TEST(content.find("$scope module top $end\n$var wire 90 ! wide $end\n") != std::string::npos);
+	BOOST_TEST(content.find("$dumpvars\n" + expectedWide + "b0X000000X01 \"\nX#\n$end\n#1234\n1#\n") != std::string::npos);
+}
+
+
+
 BOOST_AUTO_TEST_SUITE_END()
\ No newline at end of file
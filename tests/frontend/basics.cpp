@@ -21,6 +21,9 @@
 #include <boost/test/data/test_case.hpp>
 #include <boost/test/data/monomorphic.hpp>
 
+#include <gatery/hlim/coreNodes/Node_Pin.h>
+#include <gatery/simulation/ReferenceSimulator.h>
+
 using namespace boost::unit_test;
 
 using BoostUnitTestSimulationFixture = gtry::BoostUnitTestSimulationFixture;
@@ -1506,3 +1509,49 @@ BOOST_FIXTURE_TEST_CASE(testUndefinedDontCareComparison, gtry::BoostUnitTestSimu
 	design.postprocess();
 	runTest({ 1,1 });
 }
+
+BOOST_FIXTURE_TEST_CASE(CircuitSnapshotRoundTrip, BoostUnitTestSimulationFixture)
+{
+	using namespace gtry;
+
+	Clock clock({ .absoluteFrequency = 10'000 });
+	ClockScope clockScope(clock);
+
+	UInt counter = 8_b;
+	counter = reg(counter + 1, 0);
+	HCL_NAMED(counter);
+	pinOut(counter).setName("counter");
+
+	design.postprocess();
+
+	std::stringstream snapshot;
+	design.getCircuit().saveSnapshot(snapshot);
+
+	hlim::Circuit loaded;
+	loaded.loadSnapshot(snapshot);
+	BOOST_TEST(loaded.getNodes().size() == design.getCircuit().getNodes().size());
+	BOOST_TEST(loaded.getClocks().size() == design.getCircuit().getClocks().size());
+
+	std::stringstream resaved;
+	loaded.saveSnapshot(resaved);
+	BOOST_TEST(resaved.str() == snapshot.str());
+
+	auto simulateCounter = [](const hlim::Circuit &circuit) {
+		hlim::Node_Pin *pin = nullptr;
+		for (const auto &node : circuit.getNodes())
+			if (auto *p = dynamic_cast<hlim::Node_Pin*>(node.get()); p != nullptr && p->getName() == "counter")
+				pin = p;
+		BOOST_REQUIRE(pin != nullptr);
+
+		sim::ReferenceSimulator simulator(false);
+		simulator.compileProgram(circuit);
+		simulator.powerOn();
+		simulator.advance(hlim::ClockRational(105, 10'000));
+		return simulator.getValueOfOutput(pin->getDriver(0));
+	};
+
+	auto original = simulateCounter(design.getCircuit());
+	auto reloaded = simulateCounter(loaded);
+	BOOST_TEST(sim::allDefined(original, 0, original.size()));
+	BOOST_TEST(original == reloaded);
+}
@@ -121,3 +121,44 @@ BOOST_FIXTURE_TEST_CASE(CTS_TestRegisterReset, BoostUnitTestSimulationFixture)
 	BOOST_TEST(simu(c).defined() == 255);
 	BOOST_TEST(simu(c).value() == 52);
 }
+
+
+BOOST_FIXTURE_TEST_CASE(CTS_TestRewireAfterRead, BoostUnitTestSimulationFixture)
+{
+	using namespace gtry;
+
+
+	Clock clock({ .absoluteFrequency = 10'000 });
+	ClockScope clkScp(clock);
+
+	UInt a(8_b);
+	UInt c = a + 1;
+
+	BOOST_TEST(simu(c).defined() == 0);
+
+	a = reg(a, 41);
+
+	BOOST_TEST(simu(c).defined() == 255);
+	BOOST_TEST(simu(c).value() == 42);
+}
+
+BOOST_FIXTURE_TEST_CASE(CTS_TestReadThroughDefault, BoostUnitTestSimulationFixture)
+{
+	using namespace gtry;
+
+	Bit a;
+	a = BitDefault('1');
+	Bit b = a;
+	b &= true;
+
+	Bit c;
+	c = BitDefault('0');
+	Bit d = b ^ c;
+
+	size_t numSlowEvaluations = DesignScope::get()->getConstructionTimeSimContext().getNumSubnetCopyEvaluations();
+
+	BOOST_TEST(simu(b) == '1');
+	BOOST_TEST(simu(d) == '1');
+
+	BOOST_TEST(DesignScope::get()->getConstructionTimeSimContext().getNumSubnetCopyEvaluations() == numSlowEvaluations);
+}
@@ -19,6 +19,9 @@
 
 
 #include <gatery/frontend/GHDLTestFixture.h>
+#include <gatery/export/vhdl/VHDLExport.h>
+#include <gatery/export/vhdl/AST.h>
+#include <gatery/export/vhdl/Entity.h>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/data/dataset.hpp>
@@ -449,3 +452,154 @@ BOOST_FIXTURE_TEST_CASE(signalTapForcesVariableToSignal, gtry::GHDLTestFixture)
 
 
 BOOST_AUTO_TEST_SUITE_END()
+
+
+namespace {
+	std::map<std::filesystem::path, std::string> readExportedFiles(const std::filesystem::path &directory)
+	{
+		std::map<std::filesystem::path, std::string> files;
+		for (const auto &entry : std::filesystem::recursive_directory_iterator(directory)) {
+			if (!entry.is_regular_file()) continue;
+			std::ifstream file(entry.path(), std::ifstream::binary);
+			files[std::filesystem::relative(entry.path(), directory)] = std::string(std::istreambuf_iterator<char>(file), {});
+		}
+		return files;
+	}
+}
+
+BOOST_FIXTURE_TEST_CASE(parallelExportMatchesSerialExport, gtry::BoostUnitTestSimulationFixture)
+{
+	using namespace gtry;
+
+	Clock clock({ .absoluteFrequency = 100'000'000 });
+	ClockScope clkScp(clock);
+
+	UInt value = pinIn(8_b);
+	HCL_NAMED(value);
+	for (size_t i = 0; i < 16; i++) {
+		Area area("stage" + std::to_string(i), true);
+		value = reg(value + i);
+		HCL_NAMED(value);
+	}
+	pinOut(value).setName("output");
+
+	design.postprocess();
+
+	for (auto destination : { "parallelExport/multiFile/", "parallelExport/singleFile/design.vhd" }) {
+		std::filesystem::path serialDestination = std::filesystem::path("serial") / destination;
+		std::filesystem::path parallelDestination = std::filesystem::path("parallel") / destination;
+		std::filesystem::remove_all("serial");
+		std::filesystem::remove_all("parallel");
+
+		vhdl::VHDLExport serialExport(serialDestination);
+		serialExport(design.getCircuit());
+
+		vhdl::VHDLExport parallelExport(parallelDestination);
+		parallelExport.parallelExport(4);
+		parallelExport(design.getCircuit());
+
+		auto serialFiles = readExportedFiles("serial");
+		auto parallelFiles = readExportedFiles("parallel");
+		BOOST_TEST(!serialFiles.empty());
+		BOOST_TEST((serialFiles == parallelFiles));
+	}
+}
+
+BOOST_FIXTURE_TEST_CASE(incrementalExportSkipsUnchangedFiles, gtry::BoostUnitTestSimulationFixture)
+{
+	using namespace gtry;
+
+	Clock clock({ .absoluteFrequency = 100'000'000 });
+	ClockScope clkScp(clock);
+
+	UInt value = pinIn(8_b);
+	HCL_NAMED(value);
+	for (size_t i = 0; i < 4; i++) {
+		Area area("stage" + std::to_string(i), true);
+		value = reg(value + i);
+		HCL_NAMED(value);
+	}
+	pinOut(value).setName("output");
+
+	design.postprocess();
+
+	std::filesystem::remove_all("incrementalExport");
+
+	size_t numFiles;
+	{
+		vhdl::VHDLExport vhdl("incrementalExport/");
+		vhdl.incrementalExport().writeProjectFile("project.txt");
+		vhdl(design.getCircuit());
+		numFiles = vhdl.getManifest().getNumFilesWritten();
+		BOOST_TEST(numFiles > 1);
+		BOOST_TEST(vhdl.getManifest().getNumFilesSkipped() == 0);
+	}
+	{
+		vhdl::VHDLExport vhdl("incrementalExport/");
+		vhdl.incrementalExport().writeProjectFile("project.txt");
+		vhdl(design.getCircuit());
+		BOOST_TEST(vhdl.getManifest().getNumFilesWritten() == 0);
+		BOOST_TEST(vhdl.getManifest().getNumFilesSkipped() == numFiles);
+	}
+
+	std::filesystem::remove("incrementalExport/project.txt");
+	{
+		vhdl::VHDLExport vhdl("incrementalExport/");
+		vhdl.incrementalExport().writeProjectFile("project.txt");
+		vhdl(design.getCircuit());
+		BOOST_TEST(vhdl.getManifest().getNumFilesWritten() == 1);
+		BOOST_TEST(std::filesystem::exists("incrementalExport/project.txt"));
+	}
+}
+
+BOOST_FIXTURE_TEST_CASE(deduplicateIdenticalEntities, gtry::BoostUnitTestSimulationFixture)
+{
+	using namespace gtry;
+
+	Clock clock({ .absoluteFrequency = 100'000'000 });
+	ClockScope clkScp(clock);
+
+	UInt value = pinIn(8_b);
+	HCL_NAMED(value);
+	for (size_t i = 0; i < 4; i++) {
+		Area area("lane", true);
+		value = reg(value + 1);
+		HCL_NAMED(value);
+	}
+	{
+		Area area("lane", true);
+		value = reg(value + 2);
+		HCL_NAMED(value);
+	}
+	pinOut(value).setName("output");
+
+	design.postprocess();
+
+	std::filesystem::remove_all("deduplicatedExport");
+
+	vhdl::VHDLExport vhdl("deduplicatedExport/");
+	vhdl.deduplicateEntities();
+	vhdl(design.getCircuit());
+
+	auto files = readExportedFiles("deduplicatedExport");
+	size_t numLaneFiles = 0;
+	for (const auto &[path, content] : files)
+		if (path.filename().string().starts_with("lane"))
+			numLaneFiles++;
+	// The four identical lanes share one entity, the differing fifth one gets its own.
+	BOOST_TEST(numLaneFiles == 2);
+
+	auto sortedEntities = vhdl.getAST()->getDependencySortedEntities();
+	BOOST_TEST(sortedEntities.size() == 3);
+
+	std::string top = files.at(std::filesystem::path(sortedEntities.back()->getName() + ".vhd"));
+	auto countInstantiations = [&](const std::string &entityName) {
+		std::string instantiation = "entity work." + entityName + "(impl)";
+		size_t count = 0;
+		for (size_t pos = top.find(instantiation); pos != std::string::npos; pos = top.find(instantiation, pos+1))
+			count++;
+		return count;
+	};
+	size_t maxInstantiations = std::max(countInstantiations(sortedEntities[0]->getName()), countInstantiations(sortedEntities[1]->getName()));
+	BOOST_TEST(maxInstantiations == 4);
+}
@@ -24,6 +24,8 @@
 #include <gatery/hlim/GraphTools.h>
 #include <gatery/hlim/CNF.h>
 #include <gatery/hlim/RegisterRetiming.h>
+#include <gatery/hlim/SignalDelay.h>
+#include <gatery/hlim/coreNodes/Node_Register.h>
 
 #include <boost/test/unit_test.hpp>
 #include <boost/test/data/dataset.hpp>
@@ -133,6 +135,120 @@ BOOST_FIXTURE_TEST_CASE(retiming_forward_counter_old, BoostUnitTestSimulationFix
 	runTest(hlim::ClockRational(100, 1) / clock.getClk()->absoluteFrequency());
 }
 
+BOOST_FIXTURE_TEST_CASE(retiming_forward_incremental_signal_delay, BoostUnitTestSimulationFixture)
+{
+	using namespace gtry;
+
+	Clock clock({ .absoluteFrequency = 100'000'000 });
+	ClockScope clkScp(clock);
+
+	UInt a = pinIn(16_b);
+	UInt b = pinIn(16_b);
+
+	UInt sum = reg(a, 0, {.allowRetimingForward=true}) + reg(b, 0, {.allowRetimingForward=true});
+	UInt mixed = sum ^ (sum + 3);
+	UInt output = mixed + 1;
+	pinOut(output);
+
+	stripSignalNodes(design.getCircuit());
+	auto subnet = hlim::Subnet::all(design.getCircuit());
+	design.getCircuit().optimizeSubnet(subnet);
+
+	hlim::SignalDelay incremental;
+	incremental.compute(subnet);
+	auto criticalBefore = incremental.getCriticalOutput();
+	BOOST_REQUIRE(criticalBefore);
+
+	hlim::Subnet changedNodes;
+	hlim::Subnet rewiredNodes;
+	BOOST_REQUIRE(retimeForwardToOutput(design.getCircuit(), subnet, sum.readPort(), {.ignoreRefs=true, .newNodes=&changedNodes, .rewiredNodes=&rewiredNodes}));
+	BOOST_TEST(!changedNodes.empty());
+	for (auto n : rewiredNodes)
+		changedNodes.add(n);
+	incremental.update(subnet, changedNodes);
+
+	hlim::SignalDelay full;
+	full.compute(subnet);
+
+	for (auto n : subnet)
+		for (auto i : gtry::utils::Range(n->getNumOutputPorts())) {
+			hlim::NodePort np = {.node = n, .port = i};
+			BOOST_REQUIRE(incremental.contains(np) == full.contains(np));
+			auto incrementalDelay = incremental.getDelay(np);
+			auto fullDelay = full.getDelay(np);
+			BOOST_REQUIRE(incrementalDelay.size() == fullDelay.size());
+			for (auto j : gtry::utils::Range(fullDelay.size()))
+				BOOST_TEST(incrementalDelay[j] == fullDelay[j]);
+		}
+
+	auto criticalIncremental = incremental.getCriticalOutput();
+	auto criticalFull = full.getCriticalOutput();
+	BOOST_REQUIRE(criticalIncremental);
+	BOOST_REQUIRE(criticalFull);
+	BOOST_TEST((criticalIncremental->output == criticalFull->output));
+	BOOST_TEST(criticalIncremental->bit == criticalFull->bit);
+	BOOST_TEST(criticalIncremental->delay == criticalFull->delay);
+	BOOST_TEST(criticalIncremental->delay < criticalBefore->delay);
+}
+
+BOOST_FIXTURE_TEST_CASE(timing_analysis_reports_critical_paths_per_clock, BoostUnitTestSimulationFixture)
+{
+	using namespace gtry;
+
+	Clock clockA({ .absoluteFrequency = 100'000'000, .name = "clockA" });
+	Clock clockB({ .absoluteFrequency = 200'000'000, .name = "clockB" });
+
+	UInt a = pinIn(16_b);
+	UInt b = pinIn(16_b);
+	Bit c = pinIn();
+
+	UInt slow, fast;
+	{
+		ClockScope clkScp(clockA);
+		UInt ra = reg(a);
+		UInt rb = reg(b);
+		UInt sum = ra + rb;
+		setName(sum, "longSum");
+		slow = reg(sum + 3);
+		fast = reg(ra);
+	}
+	Bit inverted;
+	{
+		ClockScope clkScp(clockB);
+		inverted = reg(~reg(c));
+	}
+	pinOut(slow);
+	pinOut(fast);
+	pinOut(inverted);
+
+	auto analysis = design.analyzeTiming(2);
+	const auto &criticalPaths = analysis.getCriticalPaths();
+
+	hlim::Clock *hlimClockA = clockA.getClk();
+	hlim::Clock *hlimClockB = clockB.getClk();
+	BOOST_REQUIRE(criticalPaths.contains(hlimClockA));
+	BOOST_REQUIRE(criticalPaths.contains(hlimClockB));
+
+	const auto &pathsA = criticalPaths.find(hlimClockA)->second;
+	BOOST_REQUIRE(pathsA.size() == 2);
+	BOOST_TEST(pathsA[0].delay >= pathsA[1].delay);
+	BOOST_TEST(pathsA[0].clock == hlimClockA);
+	BOOST_REQUIRE(!pathsA[0].elements.empty());
+	BOOST_TEST(pathsA[0].elements.back().arrival == pathsA[0].delay);
+	BOOST_TEST(dynamic_cast<hlim::Node_Register*>(pathsA[0].elements.front().output.node) != nullptr);
+	for (auto i : gtry::utils::Range<size_t>(1, pathsA[0].elements.size()))
+		BOOST_TEST(pathsA[0].elements[i-1].arrival <= pathsA[0].elements[i].arrival);
+
+	const auto &pathsB = criticalPaths.find(hlimClockB)->second;
+	BOOST_REQUIRE(!pathsB.empty());
+	BOOST_TEST(pathsB[0].delay < pathsA[0].delay);
+
+	std::stringstream report;
+	analysis.writeReport(report);
+	BOOST_TEST(report.str().find("clockA") != std::string::npos);
+	BOOST_TEST(report.str().find("longSum") != std::string::npos);
+}
+
 BOOST_FIXTURE_TEST_CASE(retiming_hint_simple, BoostUnitTestSimulationFixture)
 {
 	using namespace gtry;
@@ -191,6 +307,63 @@ BOOST_FIXTURE_TEST_CASE(retiming_hint_simple_reset, BoostUnitTestSimulationFixtu
 	BOOST_TEST(pipeBalanceGroup.getNumPipeBalanceGroupStages() == 3);
 }
 
+BOOST_FIXTURE_TEST_CASE(retiming_hint_auto_pipeline, BoostUnitTestSimulationFixture)
+{
+	using namespace gtry;
+	using namespace gtry::sim;
+	using namespace gtry::utils;
+
+	Clock clock({ .absoluteFrequency = 100'000'000 });
+	ClockScope clkScp(clock);
+
+	InputPins aPin = pinIn(4_b);
+	InputPins bPin = pinIn(4_b);
+
+	PipeBalanceGroup pipeBalanceGroup;
+	pipeBalanceGroup.autoPipeline(8);
+	UInt a = pipeBalanceGroup((UInt)aPin);
+	UInt b = pipeBalanceGroup((UInt)bPin);
+
+	// A chain of adders that is way too long for one clock cycle next to a short path whose latency must still match.
+	UInt longPath = a;
+	for ([[maybe_unused]] auto i : Range(8))
+		longPath = longPath + b;
+
+	UInt shortPath = a ^ b;
+
+	auto longPin = pinOut(longPath);
+	auto shortPin = pinOut(shortPath);
+
+	design.postprocess();
+
+	size_t latency = pipeBalanceGroup.getNumPipeBalanceGroupStages();
+	BOOST_TEST(latency > 0);
+	BOOST_TEST(latency <= 8);
+
+	addSimulationProcess([=,this]()->SimProcess {
+		std::vector<std::pair<size_t, size_t>> inputs;
+		for (auto i : Range(32)) {
+			size_t valA = i % 16;
+			size_t valB = (i * 7) % 16;
+			simu(aPin) = valA;
+			simu(bPin) = valB;
+			inputs.push_back({valA, valB});
+
+			if (i >= latency) {
+				auto [expectedA, expectedB] = inputs[i - latency];
+				BOOST_TEST(simu(longPin).value() == (expectedA + 8 * expectedB) % 16);
+				BOOST_TEST(simu(shortPin).value() == (expectedA ^ expectedB));
+			}
+
+			co_await AfterClk(clock);
+		}
+
+		stopTest();
+	});
+
+	runTest(hlim::ClockRational(100, 1) / clock.getClk()->absoluteFrequency());
+}
+
 enum class TestEnum
 {
 	VAL1, VAL2
@@ -23,6 +23,15 @@
 #include <boost/test/data/monomorphic.hpp>
 
 #include <gatery/utils/ConfigTree.h>
+#include <gatery/utils/SlabAllocator.h>
+#include <gatery/hlim/Circuit.h>
+#include <gatery/hlim/coreNodes/Node_Signal.h>
+#include <gatery/hlim/NodeGroup.h>
+#include <gatery/hlim/Subnet.h>
+#include <gatery/export/DotExport.h>
+
+#include <fstream>
+#include <sstream>
 
 using namespace boost::unit_test;
 using namespace gtry::utils;
@@ -201,3 +210,90 @@ BOOST_AUTO_TEST_CASE(ConfigTreeRecorder)
 }
 
 #endif
+
+
+BOOST_AUTO_TEST_CASE(SlabAllocatorReuse)
+{
+	SlabAllocator allocator(20, 16, 4);
+	BOOST_TEST(allocator.getSlotSize() == 32);
+
+	std::vector<void*> objects;
+	for (size_t i = 0; i < 10; i++)
+		objects.push_back(allocator.allocate());
+
+	BOOST_TEST(allocator.getNumSlabs() == 3);
+	BOOST_TEST(allocator.getNumAllocated() == 10);
+	for (auto *ptr : objects)
+		BOOST_TEST((size_t)ptr % 16 == 0);
+	BOOST_TEST((std::byte*)objects[1] - (std::byte*)objects[0] == 32);
+
+	allocator.deallocate(objects[5]);
+	BOOST_TEST(allocator.allocate() == objects[5]);
+
+	for (auto *ptr : objects)
+		allocator.deallocate(ptr);
+	BOOST_TEST(allocator.getNumAllocated() == 0);
+	BOOST_TEST(allocator.getNumSlabs() == 3);
+}
+
+BOOST_AUTO_TEST_CASE(CircuitNodesInSlabs)
+{
+	gtry::hlim::Circuit circuit;
+
+	auto *a = circuit.createNode<gtry::hlim::Node_Signal>();
+	auto *b = circuit.createNode<gtry::hlim::Node_Signal>();
+	auto *c = circuit.createNode<gtry::hlim::Node_Signal>();
+	BOOST_TEST((std::byte*)c - (std::byte*)b == (std::byte*)b - (std::byte*)a);
+
+	b->connectInput({.node = a, .port = 0ull});
+	c->connectInput({.node = a, .port = 0ull});
+	BOOST_TEST(a->getDirectlyDriven(0).size() == 2);
+	b->disconnectInput();
+	c->disconnectInput();
+	BOOST_TEST(a->getDirectlyDriven(0).empty());
+
+	// Orphaned signals get removed and returned to their slab
+	circuit.cullOrphanedSignalNodes();
+	BOOST_TEST(circuit.getNodes().empty());
+
+	auto *d = circuit.createNode<gtry::hlim::Node_Signal>();
+	BOOST_TEST(((void*)d == (void*)a || (void*)d == (void*)b || (void*)d == (void*)c));
+}
+
+BOOST_AUTO_TEST_CASE(DotExportNeighborhoodAndNodeBudget)
+{
+	gtry::hlim::Circuit circuit;
+
+	auto *group = circuit.getRootNodeGroup()->addChildNodeGroup(gtry::hlim::NodeGroup::GroupType::ENTITY);
+	group->setName("collapsed");
+
+	std::vector<gtry::hlim::Node_Signal*> chain;
+	for ([[maybe_unused]] auto i : Range(12)) {
+		auto *sig = circuit.createNode<gtry::hlim::Node_Signal>();
+		sig->moveToGroup(chain.size() < 2 ? circuit.getRootNodeGroup() : group);
+		if (!chain.empty())
+			sig->connectInput({.node = chain.back(), .port = 0ull});
+		chain.push_back(sig);
+	}
+
+	auto neighborhood = gtry::extractNeighborhood(chain[5], 2);
+	BOOST_TEST(neighborhood.getNodes().size() == 5);
+	for (auto i : Range<size_t>(3, 8))
+		BOOST_TEST(neighborhood.contains(chain[i]));
+
+	gtry::DotExport exp("dot_export_node_budget.dot");
+	exp.setNodeBudget(5);
+	exp(circuit);
+
+	std::stringstream content;
+	content << std::ifstream("dot_export_node_budget.dot").rdbuf();
+	std::string dot = content.str();
+
+	// Both nodes of the root group plus one summary node for the ten nodes of the child group
+	BOOST_TEST(dot.find("10 nodes") != std::string::npos);
+	size_t numSummaries = 0;
+	for (size_t pos = dot.find("box3d"); pos != std::string::npos; pos = dot.find("box3d", pos+1))
+		numSummaries++;
+	BOOST_TEST(numSummaries == 1);
+	BOOST_TEST(dot.find("node_3[") == std::string::npos);
+}
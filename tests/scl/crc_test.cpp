@@ -175,3 +175,70 @@ BOOST_FIXTURE_TEST_CASE(crc16state, BoostUnitTestSimulationFixture)
 	design.postprocess();
 	eval();
 }
+
+BOOST_FIXTURE_TEST_CASE(crcParallelMatchesSerial, BoostUnitTestSimulationFixture)
+{
+	std::mt19937_64 rng{ 1337 };
+
+	for (const char *polynomial : { "8x07", "16x8005", "32x04C11DB7" })
+		for (size_t dataWords : { 1, 2, 4 })
+			for (size_t i = 0; i < 4; i++)
+			{
+				UInt poly = polynomial;
+				UInt remainder = ConstUInt(rng() >> (64 - poly.size()), poly.width());
+				std::string dataLiteral = std::to_string(dataWords * 64) + "x";
+				for (size_t w = 0; w < dataWords; w++)
+					dataLiteral += (boost::format("%016X") % rng()).str();
+				UInt data = dataLiteral.c_str();
+
+				UInt serial = scl::crc(remainder, data, poly);
+				UInt parallel = scl::crcParallel(remainder, data, poly);
+				sim_assert(serial == parallel) << polynomial << ": " << parallel << " should be " << serial;
+			}
+
+	design.postprocess();
+	eval();
+}
+
+BOOST_FIXTURE_TEST_CASE(crcParallelByteEnable, BoostUnitTestSimulationFixture)
+{
+	std::mt19937_64 rng{ 1337 };
+
+	for (size_t numBytes = 0; numBytes <= 6; numBytes++)
+	{
+		UInt remainder = ConstUInt(rng() >> 48, 16_b);
+		UInt data = ConstUInt(rng() >> 16, 48_b);
+		UInt byteEnable = ConstUInt((0x3Full << (6 - numBytes)) & 0x3F, 6_b);
+
+		UInt expected = remainder;
+		if (numBytes)
+			expected = scl::crc(remainder, data.upper(BitWidth{ numBytes * 8 }), "16x8005");
+
+		UInt parallel = scl::crcParallel(remainder, data, "16x8005", byteEnable);
+		sim_assert(parallel == expected) << numBytes << " bytes: " << parallel << " should be " << expected;
+	}
+
+	design.postprocess();
+	eval();
+}
+
+BOOST_FIXTURE_TEST_CASE(crc32stateByteEnable, BoostUnitTestSimulationFixture)
+{
+	// "123456789" in the lower bytes of a 16 byte beat
+	UInt beat = ConstUInt(0, 128_b);
+	std::string_view message = "123456789";
+	for (size_t i = 0; i < message.size(); i++)
+		beat(i * 8, 8_b) = ConstUInt((size_t)message[i], 8_b);
+
+	scl::CrcState state{
+		.params = scl::CrcParams::init(scl::CrcWellKnownParams::CRC_32)
+	};
+	state.init();
+	state.update(beat, ConstUInt(0x01FF, 16_b));
+	UInt crcValue = state.checksum();
+
+	sim_assert(crcValue == 0xCBF43926) << crcValue << " should be 0xCBF43926";
+
+	design.postprocess();
+	eval();
+}
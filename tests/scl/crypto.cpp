@@ -202,6 +202,78 @@ BOOST_FIXTURE_TEST_CASE(Sha2_256, gtry::BoostUnitTestSimulationFixture)
 	eval();
 }
 
+BOOST_DATA_TEST_CASE_F(BoostUnitTestSimulationFixture, Sha2_256_HashEngineLanes, data::make({ 1, 4 }) * data::make({ 1, 2 }), numLanes, blocksPerMessage)
+{
+	Clock clock({ .absoluteFrequency = 100'000'000 });
+	ClockScope clkScp(clock);
+
+	struct Message
+	{
+		std::vector<std::string_view> blocks;
+		std::string_view hash;
+	};
+	const std::vector<Message> messages = blocksPerMessage == 1 ? std::vector<Message>{
+		{ { "x80000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000" },
+			"xE3B0C44298FC1C149AFBF4C8996FB92427AE41E4649B934CA495991B7852B855" },
+		{ { "x61626380000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000018" },
+			"xBA7816BF8F01CFEA414140DE5DAE2223B00361A396177A9CB410FF61F20015AD" },
+	} : std::vector<Message>{
+		{ { "x6162636462636465636465666465666765666768666768696768696a68696a6b696a6b6c6a6b6c6d6b6c6d6e6c6d6e6f6d6e6f706e6f70718000000000000000",
+			"x000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000000001C0" },
+			"x248D6A61D20638B8E5C026930C3E6039A33CE45964FF2167F6ECEDD419DB06C1" },
+	};
+	const size_t numMessages = 32;
+
+	scl::RvPacketStream<UInt> in{ 512_b };
+	pinIn(in, "in");
+
+	scl::HashEngine<scl::Sha2_256<>> engine(1, 4);
+	engine.lanes(numLanes);
+	scl::RvStream<UInt> out = engine.generate(in);
+	pinOut(out, "out");
+
+	addSimulationProcess([&]()->SimProcess {
+		simu(valid(in)) = '0';
+		co_await OnClk(clock);
+
+		for (size_t m = 0; m < numMessages; ++m)
+		{
+			const Message& msg = messages[m % messages.size()];
+			for (size_t b = 0; b < msg.blocks.size(); ++b)
+			{
+				simu(*in) = msg.blocks[b];
+				simu(eop(in)) = b + 1 == msg.blocks.size();
+				simu(valid(in)) = '1';
+				co_await scl::performTransferWait(in, clock);
+			}
+		}
+		simu(valid(in)) = '0';
+	});
+
+	addSimulationProcess([&]()->SimProcess {
+		simu(ready(out)) = '1';
+		size_t cycles = 0;
+		for (size_t m = 0; m < numMessages; )
+		{
+			co_await OnClk(clock);
+			cycles++;
+			if (simu(valid(out)) == '1')
+				BOOST_TEST(simu(*out) == messages[m++ % messages.size()].hash);
+		}
+
+		const size_t numBlocks = numMessages * blocksPerMessage;
+		BOOST_TEST_MESSAGE("SHA-256 with " << numLanes << " lanes of " << engine.pipelineStages() << " stages: " <<
+			double(numMessages) / cycles << " hashes/cycle, " << double(numBlocks) / cycles << " blocks/cycle");
+		// one block per cycle once the pipelines are filled, unless a single lane waits for chaining values
+		if (blocksPerMessage == 1 || numLanes > engine.pipelineStages())
+			BOOST_TEST(cycles < numBlocks + 16);
+		stopTest();
+	});
+
+	design.postprocess();
+	runTest(Seconds{ 1000, 1 } / clock.absoluteFrequency());
+}
+
 BOOST_FIXTURE_TEST_CASE(Md5, gtry::BoostUnitTestSimulationFixture)
 {
 	struct md5ref
@@ -531,6 +603,89 @@ BOOST_FIXTURE_TEST_CASE(TabulationHashingTest, gtry::BoostUnitTestSimulationFixt
 	runTicks(clock.getClk(), 1024);
 }
 
+BOOST_DATA_TEST_CASE_F(gtry::BoostUnitTestSimulationFixture, TabulationHashingMultiPort, data::make({ 1, 2, 4 }) * data::make({ 1, 2 }), numKeys, readPorts)
+{
+	Clock clock({ .absoluteFrequency = 100'000'000 });
+	ClockScope clockScope(clock);
+
+	scl::TabulationHashing gen{ 16_b };
+	gen.readPortsPerTable(readPorts);
+
+	std::vector<UInt> data;
+	for (size_t i = 0; i < size_t(numKeys); ++i)
+		data.push_back(pinIn(16_b).setName("data" + std::to_string(i)));
+	std::vector<UInt> hash = gen(data);
+	for (UInt& h : hash)
+		h = reg(h, {.allowRetimingBackward=true});
+	for (size_t i = 0; i < hash.size(); ++i)
+		pinOut(hash[i]).setName("hash" + std::to_string(i));
+
+	scl::AvalonNetworkSection ports;
+	gen.updatePorts(ports);
+	ports.assignPins();
+
+	size_t memories = 0;
+	size_t memoryBits = 0;
+	for (auto& node : design.getCircuit().getNodes())
+		if (auto* mem = dynamic_cast<hlim::Node_Memory*>(node.get()))
+		{
+			memories++;
+			memoryBits += mem->getSize();
+		}
+
+	// one hasher per key would need all tables for every key
+	const size_t copies = (numKeys + readPorts - 1) / readPorts;
+	BOOST_TEST(gen.numTableCopies() == copies);
+	BOOST_TEST(memories == gen.numTables() * copies);
+	BOOST_TEST_MESSAGE("keys per cycle: " << numKeys << ", read ports per table: " << readPorts << ", memories: " << memories 
+		<< " (" << memoryBits << " bits), one hasher per key: " << gen.numTables() * numKeys << " memories");
+
+	std::array<std::array<uint16_t, 256>, 2> reference;
+	std::array<scl::AvalonMM*, 2> mm = {{
+			&ports.find("table0"), &ports.find("table1")
+	}};
+
+	addSimulationProcess([&]()->SimProcess {
+
+		std::mt19937 rng{ 1337 };
+
+		for (size_t i = 0; i < reference[0].size(); ++i)
+		{
+			for (size_t t = 0; t < reference.size(); ++t)
+			{
+				reference[t][i] = rng() & 0xFFFF;
+
+				simu(mm[t]->address) = i;
+				simu(*mm[t]->write) = '1';
+				simu(*mm[t]->writeData) = reference[t][i];
+			}
+			co_await AfterClk(clock);
+		}
+		for (scl::AvalonMM* p : mm)
+			simu(*p->write) = '0';
+
+		for (size_t i = 0; i < 16; ++i)
+			co_await AfterClk(clock);
+
+		for (size_t i = 0; i < (1 << 16); i += 97 * data.size())
+		{
+			for (size_t k = 0; k < data.size(); ++k)
+				simu(data[k]) = (i + k * 97) & 0xFFFF;
+			co_await AfterClk(clock);
+
+			for (size_t k = 0; k < data.size(); ++k)
+			{
+				const size_t key = (i + k * 97) & 0xFFFF;
+				const uint16_t refHash = reference[0][key & 0xFF] ^ reference[1][key >> 8];
+				BOOST_TEST(simu(hash[k]) == refHash);
+			}
+		}
+	});
+
+	design.postprocess();
+	runTicks(clock.getClk(), 1024);
+}
+
 BOOST_AUTO_TEST_CASE(TabulationHashingDriverBaseTest)
 {
 	TabulationHashingContext* ctx = tabulation_hashing_init(36, 36, 
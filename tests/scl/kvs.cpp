@@ -167,6 +167,163 @@ BOOST_DATA_TEST_CASE_F(gtry::BoostUnitTestSimulationFixture, TinyCookuTableLooku
 }
 
 
+BOOST_FIXTURE_TEST_CASE(TinyCuckooInsertEngine, gtry::BoostUnitTestSimulationFixture)
+{
+	Clock clock({ .absoluteFrequency = 100'000'000 });
+	ClockScope clockScope(clock);
+
+	const size_t numTables = 4;
+	const BitWidth keySize{ numTables * 4 };
+
+	InputPins lookupKey = pinIn(keySize).setName("key");
+
+	scl::TinyCuckooIn params = {
+		.key = lookupKey,
+		.hash = lookupKey,
+		.userData = 0,
+		.update = {
+			.valid = '0',
+			.tableIdx = ConstUInt(0, 2_b),
+			.itemIdx = ConstUInt(0, 4_b),
+			.item = {
+				.valid = '0',
+				.key = ConstUInt(0, keySize),
+				.value = ConstUInt(0, 8_b)
+			}
+		},
+		.numTables = numTables,
+	};
+
+	scl::TinyCuckooInsertEngine engine{
+		.request = scl::RvStream<scl::TinyCuckooItem>{ constructFrom(params.update.item) },
+		.hash = [](const UInt& key) { return key; },
+	};
+	pinIn(engine.request, "insert");
+
+	scl::TinyCuckooOut result = scl::tinyCuckoo(params, engine);
+	OutputPin outFound = pinOut(result.found).setName("found");
+	OutputPins outValue = pinOut(result.value).setName("value");
+	OutputPin outFailed = pinOut(engine.failed).setName("failed");
+
+	const size_t invalid = std::numeric_limits<size_t>::max();
+	const size_t numKeys = 40;
+	std::map<size_t, size_t> reference;
+	// keys whose request is in the pipeline can not be checked against the reference
+	std::map<size_t, size_t> lastTouched;
+	size_t cycle = 0;
+	size_t inserts = 0;
+	size_t insertCycles = 0;
+	size_t failures = 0;
+	size_t lookupStalls = 0;
+	size_t lookupErrors = 0;
+
+	std::vector<size_t> keys;
+	{
+		std::mt19937 rng{ 4711 };
+		std::set<size_t> unique;
+		while (unique.size() < numKeys)
+			unique.insert(rng() & keySize.mask());
+		keys.assign(unique.begin(), unique.end());
+		std::shuffle(keys.begin(), keys.end(), rng);
+	}
+
+	addSimulationProcess([&]()->SimProcess {
+		std::mt19937 rng{ 1337 };
+		simu(valid(engine.request)) = '0';
+		co_await OnClk(clock);
+
+		const size_t start = cycle;
+		for (size_t i = 0; i < keys.size(); ++i)
+		{
+			const size_t value = rng() & 0xFF;
+			simu(valid(engine.request)) = '1';
+			simu(engine.request->valid) = '1';
+			simu(engine.request->key) = keys[i];
+			simu(engine.request->value) = value;
+			lastTouched[keys[i]] = invalid;
+			co_await scl::performTransferWait(engine.request, clock);
+			reference[keys[i]] = value;
+			lastTouched[keys[i]] = cycle;
+			inserts++;
+
+			if (i % 4 == 3)
+			{
+				// remove an earlier key
+				const size_t removeKey = keys[rng() % i];
+				simu(engine.request->valid) = '0';
+				simu(engine.request->key) = removeKey;
+				lastTouched[removeKey] = invalid;
+				co_await scl::performTransferWait(engine.request, clock);
+				reference.erase(removeKey);
+				lastTouched[removeKey] = cycle;
+			}
+		}
+		simu(valid(engine.request)) = '0';
+		insertCycles = cycle - start;
+	});
+
+	addSimulationProcess([&]()->SimProcess {
+		std::mt19937 rng{ 1338 };
+		while (true)
+		{
+			size_t key = keys[rng() % keys.size()];
+			if (rng() % 4 == 0)
+				key = rng() & keySize.mask();
+			simu(lookupKey) = key;
+			co_await AfterClk(clock);
+		}
+	});
+
+	addSimulationProcess([&]()->SimProcess {
+		std::deque<size_t> lookupQueue;
+
+		while (true)
+		{
+			co_await OnClk(clock);
+			cycle++;
+
+			if (simu(outFailed) == '1')
+				failures++;
+
+			if (lookupQueue.size() == params.latency)
+			{
+				const size_t expected = lookupQueue.back();
+				lookupQueue.pop_back();
+				if (!simu(outFound).allDefined())
+					lookupStalls++;
+				else if (expected != invalid - 1)
+				{
+					const bool match = simu(outFound) == '1' ? expected == simu(outValue) : expected == invalid;
+					if (!match)
+						lookupErrors++;
+				}
+			}
+
+			const size_t key = simu(lookupKey);
+			auto touched = lastTouched.find(key);
+			if (touched != lastTouched.end() && (touched->second == invalid || touched->second + 2 > cycle))
+			{
+				// skip lookups racing with a request of the same key
+				lookupQueue.push_front(invalid - 1);
+				continue;
+			}
+
+			auto it = reference.find(key);
+			lookupQueue.push_front(it == reference.end() ? invalid : it->second);
+		}
+	});
+
+	design.postprocess();
+	runTicks(clock.getClk(), 2048);
+
+	BOOST_TEST(insertCycles != 0);
+	BOOST_TEST(failures == 0);
+	BOOST_TEST(lookupStalls == 0);
+	BOOST_TEST(lookupErrors == 0);
+	const double insertsPerCycle = inserts / double(insertCycles);
+	BOOST_TEST_MESSAGE("inserts per cycle: " << insertsPerCycle << ", inserts per second at 100 MHz: " << insertsPerCycle * 100e6 << ", lookup stall cycles: " << lookupStalls);
+}
+
 BOOST_DATA_TEST_CASE_F(gtry::BoostUnitTestSimulationFixture, TinyCuckooTableLookup, data::xrange(3, 4), numTables)
 {
 	Clock clock({ .absoluteFrequency = 100'000'000 });
@@ -690,6 +690,72 @@ BOOST_FIXTURE_TEST_CASE(sdram_constroller_fuzz_test, SdramControllerTest)
 	});
 }
 
+BOOST_DATA_TEST_CASE_F(SdramControllerTest, sdram_controller_bank_parallel_benchmark, data::make({ 0, 4 }), queueDepth)
+{
+	setupLink();
+	bankQueueDepth(queueDepth);
+	generate(link);
+	linkModel.probability(1.0f, 1.0f);
+	timeout(hlim::ClockRational{ 200, 1'000'000 });
+
+	addSimulationProcess([=, this]()->SimProcess
+	{
+		std::mt19937_64 rng{ 4321 };
+		const size_t numRequests = 64;
+		const size_t logByteSize = 1;
+
+		// runs of four requests to the same bank, mostly to different rows
+		std::vector<uint64_t> address(numRequests);
+		for (size_t i = 0; i < numRequests; ++i)
+			address[i] = (i / 4 % 4) << 21 | (rng() % 16) << 9 | (rng() % 256) << 1;
+
+		auto cycle = std::make_shared<size_t>(0);
+		fork([=, this]()->SimProcess {
+			while (true)
+			{
+				co_await OnClk(clock());
+				(*cycle)++;
+			}
+		});
+
+		co_await OnClk(clock());
+		fork(scl::validate(linkModel.getLink(), clock()));
+
+		for (size_t i = 0; i < numRequests; ++i)
+			co_await linkModel.put(address[i], logByteSize, address[i] * 3, clock());
+
+		const size_t start = *cycle;
+		auto latencySum = std::make_shared<size_t>(0);
+		auto completed = std::make_shared<size_t>(0);
+		for (size_t i = 0; i < numRequests; ++i)
+		{
+			fork([=, this]()->SimProcess {
+				const size_t issue = *cycle;
+				auto [value, defined, error] = co_await linkModel.get(address[i], logByteSize, clock());
+				BOOST_TEST(!error);
+				BOOST_TEST(value == (address[i] * 3 & 0xFFFF));
+				*latencySum += *cycle - issue;
+				(*completed)++;
+			});
+		}
+
+		while (*completed != numRequests)
+			co_await OnClk(clock());
+		const size_t cycles = *cycle - start;
+
+		const double bytesPerCycle = double(numRequests << logByteSize) / cycles;
+		BOOST_TEST_MESSAGE("sdram bank queue depth " << queueDepth << ": " << bytesPerCycle << " bytes/cycle, " <<
+			double(*latencySum) / numRequests << " cycles average time to complete a read");
+
+		// Without queues a run of one bank costs close to a row cycle per request. With queues the banks overlap
+		// and the command bus (activate, read, precharge per request) becomes the limit.
+		if (queueDepth != 0)
+			BOOST_TEST(cycles < numRequests * m_timing.rc * 2 / 3);
+
+		stopTest();
+	});
+}
+
 BOOST_FIXTURE_TEST_CASE(sdram_constroller_memory_tester_test, SdramControllerTest)
 {
 	addressMap({
@@ -400,27 +400,37 @@ protected:
 
 	template<scl::StreamSignal T>
 	void simulateRecvData(const T& stream)
+	{
+		simulateRecvData(std::vector<const T*>{ &stream });
+	}
+
+	/// Checks the data of several sinks that together receive every group in order, such as the outputs of a multi grant arbiter.
+	template<scl::StreamSignal T>
+	void simulateRecvData(const std::vector<const T*>& streams)
 	{
 		auto recvClock = ClockScope::getClk();
 
-		auto myTransfer = pinOut(transfer(stream)).setName("simulateRecvData_transfer");
+		std::vector<OutputPin> transfers;
+		for (size_t i = 0; i < streams.size(); ++i)
+			transfers.push_back(pinOut(transfer(*streams[i])).setName("simulateRecvData_transfer" + (i ? std::to_string(i) : std::string{})));
 
-		addSimulationProcess([=, this, &stream]()->SimProcess {
+		addSimulationProcess([=, this]()->SimProcess {
 			std::vector<size_t> expectedValue(m_groups);
 			while (true)
 			{
 				co_await OnClk(recvClock);
 
-				if (simu(myTransfer) == '1')
-				{
-					size_t data = simu(*(stream.operator ->()));
-					BOOST_TEST(data / m_transfers < expectedValue.size());
-					if (data / m_transfers < expectedValue.size())
+				for (size_t i = 0; i < streams.size(); ++i)
+					if (simu(transfers[i]) == '1')
 					{
-						BOOST_TEST(data % m_transfers == expectedValue[data / m_transfers]);
-						expectedValue[data / m_transfers]++;
+						size_t data = simu(*(streams[i]->operator ->()));
+						BOOST_TEST(data / m_transfers < expectedValue.size());
+						if (data / m_transfers < expectedValue.size())
+						{
+							BOOST_TEST(data % m_transfers == expectedValue[data / m_transfers]);
+							expectedValue[data / m_transfers]++;
+						}
 					}
-				}
 
 				if (std::ranges::all_of(expectedValue, [=, this](size_t val) { return val == m_transfers; }))
 				{
@@ -720,6 +730,56 @@ BOOST_FIXTURE_TEST_CASE(streamArbiter_rrb5_packet, StreamTransferFixture)
 	runTicks(m_clock.getClk(), 1024);
 }
 
+BOOST_FIXTURE_TEST_CASE(pipelinedStreamArbiter_rr9_packet, StreamTransferFixture)
+{
+	ClockScope clkScp(m_clock);
+
+	scl::PipelinedStreamArbiter<scl::RvPacketStream<UInt>, scl::ArbiterPolicyRoundRobin> arbiter{ 1, 4 };
+	std::array<scl::RvPacketStream<UInt>, 9> in;
+	for(size_t i = 0; i < in.size(); ++i)
+	{
+		*in[i] = 10_b;
+		In(in[i], "in" + std::to_string(i) + "_");
+		simulateArbiterTestSource(in[i]);
+		arbiter.attach(in[i]);
+	}
+	arbiter.generate();
+
+	Out(arbiter.out());
+	simulateArbiterTestSink(arbiter.out());
+
+	design.postprocess();
+	BOOST_TEST(!runHitsTimeout({ 50, 1'000'000 }));
+}
+
+BOOST_FIXTURE_TEST_CASE(pipelinedStreamArbiter_low9_2out_packet, StreamTransferFixture)
+{
+	ClockScope clkScp(m_clock);
+
+	scl::PipelinedStreamArbiter<scl::RvPacketStream<UInt>> arbiter{ 2, 4 };
+	std::array<scl::RvPacketStream<UInt>, 9> in;
+	for(size_t i = 0; i < in.size(); ++i)
+	{
+		*in[i] = 10_b;
+		In(in[i], "in" + std::to_string(i) + "_");
+		simulateArbiterTestSource(in[i]);
+		arbiter.attach(in[i]);
+	}
+	arbiter.generate();
+
+	std::vector<const scl::RvPacketStream<UInt>*> outputs;
+	for (size_t i = 0; i < arbiter.numOutputs(); ++i)
+	{
+		Out(arbiter.out(i), "out" + std::to_string(i) + "_");
+		simulateBackPressure(arbiter.out(i));
+		outputs.push_back(&arbiter.out(i));
+	}
+	simulateRecvData(outputs);
+
+	design.postprocess();
+	BOOST_TEST(!runHitsTimeout({ 50, 1'000'000 }));
+}
+
 BOOST_FIXTURE_TEST_CASE(stream_extendWidth, StreamTransferFixture)
 {
 	ClockScope clkScp(m_clock);
@@ -1435,3 +1495,115 @@ BOOST_FIXTURE_TEST_CASE(addReadyAndFailOnBackpressure_sop_test, StreamTransferFi
 	design.postprocess();
 	BOOST_TEST(!runHitsTimeout({ 50, 1'000'000 }));
 }
+
+BOOST_FIXTURE_TEST_CASE(stream_gearbox_packetSizeSweep, BoostUnitTestSimulationFixture)
+{
+	Clock clock({ .absoluteFrequency = 100'000'000 });
+	ClockScope clkScp(clock);
+
+	const size_t srcBytes = 8;
+	const size_t outBytes = 16;
+	const size_t maxPacketsPerBeat = 2;
+	const size_t numPackets = 16;
+	const std::vector<size_t> packetSizes = { 1, 5, 8, 9, 16, 17, 33 };
+
+	struct Result {
+		size_t beats = 0;
+		size_t packets = 0;
+	};
+	std::vector<Result> results(packetSizes.size());
+
+	auto payloadByte = [](size_t packet, size_t byte) { return uint8_t(packet * 31 + byte); };
+
+	// The simulation processes refer to the streams, so they must outlive the loop.
+	std::list<scl::RvPacketStream<BVec, scl::ByteEnable>> inputs;
+	std::list<scl::RvStream<BVec, scl::ByteEnable, scl::PacketEnds>> outputs;
+
+	for (size_t sizeIdx = 0; sizeIdx < packetSizes.size(); sizeIdx++)
+	{
+		const size_t packetSize = packetSizes[sizeIdx];
+
+		auto& in = inputs.emplace_back(BitWidth{ srcBytes * 8 });
+		byteEnable(in) = BitWidth{ srcBytes };
+		pinIn(in, "in" + std::to_string(packetSize));
+
+		auto& out = outputs.emplace_back(scl::gearbox(in, BitWidth{ outBytes * 8 }, maxPacketsPerBeat));
+		pinOut(out, "out" + std::to_string(packetSize));
+
+		addSimulationProcess([=, &in]()->SimProcess {
+			simu(valid(in)) = '0';
+			co_await OnClk(clock);
+
+			for (size_t packet = 0; packet < numPackets; packet++)
+				for (size_t offset = 0; offset < packetSize; offset += srcBytes)
+				{
+					size_t bytes = std::min(srcBytes, packetSize - offset);
+					std::vector<uint8_t> beat(srcBytes, 0);
+					for (size_t i = 0; i < bytes; i++)
+						beat[i] = payloadByte(packet, offset + i);
+
+					simu(valid(in)) = '1';
+					simu(*in) = beat;
+					simu(byteEnable(in)) = (1ull << bytes) - 1;
+					simu(eop(in)) = offset + bytes == packetSize;
+					co_await scl::performTransferWait(in, clock);
+				}
+			simu(valid(in)) = '0';
+		});
+
+		addSimulationProcess([=, &out, &results]()->SimProcess {
+			simu(ready(out)) = '1';
+			Result &result = results[sizeIdx];
+			std::vector<uint8_t> packet;
+
+			while (true)
+			{
+				co_await OnClk(clock);
+				if (simu(valid(out)) != '1')
+					continue;
+
+				result.beats++;
+				std::vector<uint8_t> beat = simu(*out);
+				uint64_t enables = simu(byteEnable(out));
+				uint64_t ends = simu(packetEnds(out));
+
+				size_t endsInBeat = 0;
+				for (size_t i = 0; i < outBytes; i++)
+				{
+					if (!(enables & (1ull << i)))
+					{
+						BOOST_TEST(!(ends & (1ull << i)));
+						continue;
+					}
+					packet.push_back(beat[i]);
+
+					if (ends & (1ull << i))
+					{
+						BOOST_TEST(packet.size() == packetSize);
+						for (size_t j = 0; j < std::min(packet.size(), packetSize); j++)
+							BOOST_TEST(packet[j] == payloadByte(result.packets, j));
+						packet.clear();
+						result.packets++;
+						endsInBeat++;
+					}
+				}
+				BOOST_TEST(endsInBeat <= maxPacketsPerBeat);
+			}
+		});
+	}
+
+	design.postprocess();
+	runTicks(clock.getClk(), 256);
+
+	for (size_t sizeIdx = 0; sizeIdx < packetSizes.size(); sizeIdx++)
+	{
+		const size_t packetSize = packetSizes[sizeIdx];
+		const Result &result = results[sizeIdx];
+		BOOST_TEST(result.packets == numPackets);
+
+		// Dense packing needs as many beats as the bytes or the packet limit dictate, plus one partially filled final beat.
+		size_t minBeats = std::max((numPackets * packetSize + outBytes - 1) / outBytes, (numPackets + maxPacketsPerBeat - 1) / maxPacketsPerBeat);
+		BOOST_TEST(result.beats <= minBeats + 1);
+		BOOST_TEST_MESSAGE("gearbox " << srcBytes << " -> " << outBytes << " bytes, packet size " << packetSize << ": " << double(result.beats) / numPackets << " beats per packet");
+	}
+}
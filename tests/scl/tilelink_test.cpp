@@ -628,6 +628,111 @@ BOOST_FIXTURE_TEST_CASE(tilelink_hub_test, BoostUnitTestSimulationFixture)
 #endif
 }
 
+BOOST_FIXTURE_TEST_CASE(tilelink_hub_mixed_latency_throughput_test, BoostUnitTestSimulationFixture)
+{
+	Clock clock({ .absoluteFrequency = 100'000'000 });
+	ClockScope clkScp(clock);
+
+	struct InitiatorState {
+		uint64_t inFlight = 0;
+		size_t completed = 0;
+	};
+
+	// Keeps up to four requests with distinct source ids in flight and counts the responses.
+	auto driveInitiator = [&](std::shared_ptr<TileLinkSimuInitiator<>> initiator, std::shared_ptr<InitiatorState> state, uint64_t address) {
+		addSimulationProcess([=]()->SimProcess {
+			auto& link = initiator->link();
+			initiator->issueIdle();
+			simu(ready(*link.d)) = '1';
+
+			for (size_t id = 0; ; id = (id + 1) % 4)
+			{
+				while (state->inFlight & (1ull << id))
+				{
+					simu(valid(link.a)) = '0';
+					co_await OnClk(clock);
+				}
+				initiator->issueCommand(TileLinkA::Get, address, 0, 2, id);
+				simu(valid(link.a)) = '1';
+				co_await performTransferWait(link.a, clock);
+				state->inFlight |= 1ull << id;
+			}
+		});
+		addSimulationProcess([=]()->SimProcess {
+			auto& link = initiator->link();
+			while (true)
+			{
+				co_await OnClk(clock);
+				if (simu(valid(*link.d)) == '1' && simu(ready(*link.d)) == '1')
+				{
+					state->inFlight &= ~(1ull << (uint64_t)simu((*link.d)->source));
+					state->completed++;
+				}
+			}
+		});
+	};
+
+	// Serves one request at a time and responds after the given number of cycles.
+	auto driveTarget = [&](std::shared_ptr<TileLinkSimuTarget<>> target, size_t latency) {
+		addSimulationProcess([=]()->SimProcess {
+			auto& link = target->link();
+			target->issueIdle();
+			simu(ready(link.a)) = '1';
+			while (true)
+			{
+				co_await OnClk(clock);
+				if (simu(valid(link.a)) == '1' && simu(ready(link.a)) == '1')
+				{
+					target->issueResponse(TileLinkD::AccessAckData, 0xC0FFEE);
+					simu(ready(link.a)) = '0';
+					for (size_t i = 0; i < latency; ++i)
+						co_await OnClk(clock);
+					simu(valid(*link.d)) = '1';
+					co_await performTransferWait(*link.d, clock);
+					simu(valid(*link.d)) = '0';
+					simu(ready(link.a)) = '1';
+				}
+			}
+		});
+	};
+
+	std::array<std::shared_ptr<InitiatorState>, 2> fastCompleted;
+	for (size_t queueDepth : { 0, 4 })
+	{
+		std::string prefix = "hub" + std::to_string(queueDepth) + "_";
+		auto slowInitiator = std::make_shared<TileLinkSimuInitiator<>>(32_b, 32_b, 2_b, 2_b, prefix + "slowInitiator");
+		auto fastInitiator = std::make_shared<TileLinkSimuInitiator<>>(32_b, 32_b, 2_b, 2_b, prefix + "fastInitiator");
+
+		TileLinkHub<TileLinkUL> hub;
+		hub.requestQueueDepth(queueDepth);
+		hub.attachSource(slowInitiator->link());
+		hub.attachSource(fastInitiator->link());
+
+		auto slowTarget = std::make_shared<TileLinkSimuTarget<>>(31_b, 32_b, 2_b, hub.sourceWidth(), prefix + "slowTarget");
+		auto fastTarget = std::make_shared<TileLinkSimuTarget<>>(31_b, 32_b, 2_b, hub.sourceWidth(), prefix + "fastTarget");
+		hub.attachSink(slowTarget->link(), 0x0000'0000);
+		hub.attachSink(fastTarget->link(), 0x8000'0000);
+		hub.generate();
+
+		auto slowState = std::make_shared<InitiatorState>();
+		auto fastState = std::make_shared<InitiatorState>();
+		driveInitiator(slowInitiator, slowState, 0x0000'0000);
+		driveInitiator(fastInitiator, fastState, 0x8000'0000);
+		driveTarget(slowTarget, 32);
+		driveTarget(fastTarget, 0);
+
+		fastCompleted[queueDepth ? 1 : 0] = fastState;
+	}
+
+	design.postprocess();
+	runTicks(clock.getClk(), 512);
+
+	// Without queues, requests for the slow sink block the fast one most of the time.
+	BOOST_TEST_MESSAGE("fast sink responses without queues: " << fastCompleted[0]->completed << ", with queues: " << fastCompleted[1]->completed);
+	BOOST_TEST(fastCompleted[1]->completed > 4 * fastCompleted[0]->completed);
+	BOOST_TEST(fastCompleted[1]->completed > 100);
+}
+
 BOOST_FIXTURE_TEST_CASE(tilelink_memory_test, BoostUnitTestSimulationFixture)
 {
 	Clock clock({ .absoluteFrequency = 100'000'000 });
@@ -814,6 +919,130 @@ BOOST_FIXTURE_TEST_CASE(tilelink_stream_fetch_test, BoostUnitTestSimulationFixtu
 	runTicks(clock.getClk(), 128);
 }
 
+BOOST_FIXTURE_TEST_CASE(tilelink_stream_fetch_burst_benchmark, BoostUnitTestSimulationFixture)
+{
+	Clock clock({ .absoluteFrequency = 100'000'000 });
+	ClockScope clkScp(clock);
+
+	const size_t latency = 32;
+	const size_t numBeats = 32;
+	const uint64_t startAddress = 0x100;
+
+	// Accepts a request every cycle and answers each one in order after a fixed latency, one beat per cycle.
+	auto latencyMemory = [&](auto link) {
+		addSimulationProcess([=]()->SimProcess {
+			struct Request { size_t due; uint64_t address; size_t beats; uint64_t source; uint64_t size; };
+			std::deque<Request> pending;
+			const size_t beatBytes = link->a->mask.width().bits();
+			size_t beat = 0;
+
+			simu(ready(link->a)) = '1';
+			simu(valid(*link->d)) = '0';
+			for (size_t cycle = 0; ; ++cycle)
+			{
+				co_await OnClk(clock);
+				if (simu(valid(link->a)) == '1')
+				{
+					const uint64_t size = simu(link->a->size);
+					pending.push_back({ cycle + latency, simu(link->a->address), std::max<size_t>((1ull << size) / beatBytes, 1), simu(link->a->source), size });
+				}
+				if (simu(valid(*link->d)) == '1' && simu(ready(*link->d)) == '1' && ++beat == pending.front().beats)
+				{
+					pending.pop_front();
+					beat = 0;
+				}
+
+				simu(valid(*link->d)) = '0';
+				if (!pending.empty() && pending.front().due <= cycle)
+				{
+					const Request& req = pending.front();
+					uint64_t word = 0;
+					for (size_t b = 0; b < beatBytes; ++b)
+						word |= ((req.address + beat * beatBytes + b) & 0xFF) << (b * 8);
+
+					simu((*link->d)->opcode) = (uint64_t)TileLinkD::AccessAckData;
+					simu((*link->d)->param) = 0;
+					simu((*link->d)->size) = req.size;
+					simu((*link->d)->source) = req.source;
+					simu((*link->d)->sink) = 0;
+					simu((*link->d)->error) = '0';
+					simu((*link->d)->data) = word;
+					simu(valid(*link->d)) = '1';
+				}
+			}
+		});
+	};
+
+	// Fetches numBeats beats and returns the number of cycles until the last one was received.
+	auto fetchBenchmark = [&](auto cmd, auto data) {
+		auto cycles = std::make_shared<size_t>(0);
+		addSimulationProcess([=]()->SimProcess {
+			simu((*cmd)->address) = startAddress;
+			simu((*cmd)->beats) = numBeats;
+			simu(valid(*cmd)) = '1';
+			co_await performTransferWait(*cmd, clock);
+			simu(valid(*cmd)) = '0';
+		});
+		addSimulationProcess([=]()->SimProcess {
+			simu(ready(*data)) = '1';
+			for (size_t received = 0, cycle = 1; received < numBeats; ++cycle)
+			{
+				co_await OnClk(clock);
+				if (simu(valid(*data)) == '1')
+				{
+					const uint64_t byte = startAddress + received * 4;
+					const uint64_t expected = (((byte + 3) & 0xFF) << 24) | (((byte + 2) & 0xFF) << 16) | (((byte + 1) & 0xFF) << 8) | (byte & 0xFF);
+					BOOST_TEST(simu(**data) == expected);
+					if (++received == numBeats)
+						*cycles = cycle;
+				}
+			}
+		});
+		return cycles;
+	};
+
+	auto makeStreams = [&](std::string prefix) {
+		auto cmd = std::make_shared<RvStream<TileLinkStreamFetch::Command>>();
+		(*cmd)->address = 16_b;
+		(*cmd)->beats = 8_b;
+		pinIn(*cmd, prefix + "cmd");
+
+		auto data = std::make_shared<RvStream<BVec>>();
+		**data = 32_b;
+		return std::make_pair(cmd, data);
+	};
+
+	auto [singleCmd, singleData] = makeStreams("single_");
+	TileLinkStreamFetch singleFetcher;
+	auto singleLink = std::make_shared<TileLinkUL>(singleFetcher.generate(*singleCmd, *singleData));
+	pinOut(*singleData, "single_data");
+	pinOut(*singleLink, "single_link");
+	latencyMemory(singleLink);
+	auto singleCycles = fetchBenchmark(singleCmd, singleData);
+
+	auto [burstCmd, burstData] = makeStreams("burst_");
+	TileLinkStreamFetch burstFetcher;
+	burstFetcher.maxOutstanding(8).maxBurstBeats(4);
+	auto burstLink = std::make_shared<TileLinkUH>(burstFetcher.generateBurst(*burstCmd, *burstData));
+	pinOut(*burstData, "burst_data");
+	pinOut(*burstLink, "burst_link");
+	latencyMemory(burstLink);
+	auto burstCycles = fetchBenchmark(burstCmd, burstData);
+
+	design.getCircuit().postprocess(gtry::DefaultPostprocessing{});
+	runTicks(clock.getClk(), 2048);
+
+	BOOST_TEST(*singleCycles != 0);
+	BOOST_TEST(*burstCycles != 0);
+	if (*singleCycles != 0 && *burstCycles != 0)
+	{
+		const double singleRate = numBeats * 4.0 / *singleCycles;
+		const double burstRate = numBeats * 4.0 / *burstCycles;
+		BOOST_TEST_MESSAGE("stream fetch with " << latency << " cycles memory latency: single request " << singleRate << " bytes/cycle, 8 outstanding bursts of 4 beats " << burstRate << " bytes/cycle");
+		BOOST_TEST(burstRate > singleRate * 8);
+	}
+}
+
 class LinkTest : public ClockedTest
 {
 public:
@@ -81,6 +81,84 @@ BOOST_FIXTURE_TEST_CASE(PriorityEncoderTreeTest, gtry::BoostUnitTestSimulationFi
 	eval();
 }
 
+BOOST_DATA_TEST_CASE_F(gtry::BoostUnitTestSimulationFixture, ParallelPrefixOneHot, data::make({ 37, 1024 }) * data::make({ 0, 1, 4 }), width, numRegisterSteps)
+{
+	Clock clock({ .absoluteFrequency = 100'000'000 });
+	ClockScope clkScp(clock);
+
+	const size_t findCount = 3;
+	const size_t numWords = (width + 63) / 64;
+
+	std::vector<UInt> words;
+	for (size_t w = 0; w < numWords; ++w)
+		words.push_back(pinIn(BitWidth{ std::min<size_t>(64, width - w * 64) }).setName("in" + std::to_string(w)));
+	UInt in = pack(words);
+
+	scl::VStream<UInt> prio = priorityEncoderPrefix(in, numRegisterSteps);
+	std::vector<scl::VStream<UInt>> first = findFirstSet(in, findCount, numRegisterSteps);
+	UInt count = bitcountTree(in, numRegisterSteps);
+
+	pinOut(*prio).setName("prio");
+	pinOut(valid(prio)).setName("prio_valid");
+	for (size_t n = 0; n < findCount; ++n)
+	{
+		pinOut(*first[n]).setName("first" + std::to_string(n));
+		pinOut(valid(first[n])).setName("first_valid" + std::to_string(n));
+	}
+	pinOut(count).setName("count");
+
+	addSimulationProcess([&]()->SimProcess {
+		std::mt19937_64 rng{ 1337 };
+		std::deque<std::vector<size_t>> expected;
+
+		for (size_t i = 0; i < 64; ++i)
+		{
+			// vary the density from empty to full
+			std::vector<size_t> setBits;
+			const size_t density = i % 8;
+			for (size_t w = 0; w < numWords; ++w)
+			{
+				uint64_t value = density == 0 ? 0 : ~0ull;
+				for (size_t d = 1; d < density; ++d)
+					value &= rng();
+				if (density == 7)
+					value = 1ull << (rng() % 64);
+				if (density == 6)
+					value = w == numWords - 1 ? 1ull << (rng() % words[w].size()) : 0;
+
+				value &= words[w].width().mask();
+				simu(words[w]) = value;
+				for (size_t b = 0; b < words[w].size(); ++b)
+					if (value & (1ull << b))
+						setBits.push_back(w * 64 + b);
+			}
+			expected.push_front(setBits);
+
+			co_await AfterClk(clock);
+
+			if (expected.size() >= size_t(numRegisterSteps))
+			{
+				const std::vector<size_t>& ref = expected.back();
+				BOOST_TEST(simu(count) == ref.size());
+				BOOST_TEST(simu(valid(prio)) == !ref.empty());
+				if (!ref.empty())
+					BOOST_TEST(simu(*prio) == ref.front());
+				for (size_t n = 0; n < findCount; ++n)
+				{
+					BOOST_TEST(simu(valid(first[n])) == (n < ref.size()));
+					if (n < ref.size())
+						BOOST_TEST(simu(*first[n]) == ref[n]);
+				}
+				expected.pop_back();
+			}
+		}
+		stopTest();
+	});
+
+	design.postprocess();
+	runTest(Seconds{ 1000, 1 } / clock.absoluteFrequency());
+}
+
 BOOST_FIXTURE_TEST_CASE(addWithCarry, BoostUnitTestSimulationFixture)
 {
 	Clock clock({ .absoluteFrequency = 100'000'000 });